@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file AnalogLadderSource.hpp
+ * @brief Resistor-ladder buttons on one ADC pin, sampled continuously by DMA
+ *
+ * ADC1 runs in continuous conversion mode on the ladder pin and every result
+ * is copied by DMA into a small circular buffer. poll() never starts or
+ * waits for a conversion: it averages the buffer, classifies the voltage
+ * band (LadderClassifier, holding the key across boundaries) and runs the
+ * result through the same Debouncer and InputPipeline as the GPIO buttons.
+ *
+ * ADC1 is dedicated to the ladder once begin() has run: do not analogRead()
+ * ADC1 pins afterwards.
+ */
+
+#include <Arduino.h>
+#include <DMAChannel.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Debouncer.hpp"
+#include "LadderClassifier.hpp"
+#include "Trace.hpp"
+
+namespace example {
+
+template <size_t BUTTONS>
+struct LadderDef {
+    uint8_t pin;
+    std::array<uint8_t, BUTTONS> ids;       ///< Button id per band
+    std::array<uint16_t, BUTTONS> centers;  ///< 10-bit ADC reading per band
+    uint16_t idle;                          ///< Reading with nothing pressed
+    uint16_t hysteresis;
+};
+
+/**
+ * @tparam BUTTONS Buttons on the ladder
+ * @tparam SAMPLES DMA ring length (averaged on each poll)
+ */
+template <size_t BUTTONS, size_t SAMPLES = 16>
+class AnalogLadderSource : public Traced {
+public:
+    /**
+     * @param samples DMA target: must not be in cached memory (a plain
+     *                global lands in DTCM, which is fine)
+     */
+    AnalogLadderSource(const LadderDef<BUTTONS>& def, volatile uint16_t (&samples)[SAMPLES], uint32_t debounceUs)
+        : def_(def), samples_(samples),
+          classifier_(def.centers, def.idle, def.hysteresis), debouncer_(debounceUs) {}
+
+    void begin() {
+        // One blocking read configures the pin mux, resolution and channel
+        analogReadResolution(10);
+        analogRead(def_.pin);
+        const uint32_t channel = ADC1_HC0 & 0x1F;
+
+        for (size_t i = 0; i < SAMPLES; ++i) samples_[i] = def_.idle;
+        dma_.begin();
+        dma_.source(*reinterpret_cast<volatile uint16_t*>(&ADC1_R0));
+        dma_.destinationBuffer(samples_, sizeof(samples_));
+        dma_.triggerAtHardwareEvent(DMAMUX_SOURCE_ADC1);
+        dma_.enable();
+
+        ADC1_GC |= ADC_GC_ADCO | ADC_GC_DMAEN;  // Continuous conversions, DMA request per result
+        ADC1_HC0 = channel;                     // Writing the channel starts the sequence
+    }
+
+    template <typename Pipeline>
+    void poll(Pipeline& pipeline, uint32_t nowUs) {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < SAMPLES; ++i) sum += samples_[i];
+        const uint8_t band = classifier_.classify(static_cast<uint16_t>(sum / SAMPLES));
+        const uint32_t raw = band == LadderClassifier<BUTTONS>::NONE ? 0 : (1u << band);
+
+        const uint32_t changed = debouncer_.update(raw, nowUs);
+        for (uint32_t bits = changed; bits; bits &= bits - 1) {
+            const uint32_t i = __builtin_ctz(bits);
+            const bool pressed = (debouncer_.state() >> i) & 1u;
+            EX_TRACE_INSTANT(tracer_, "ladder", def_.ids[i], pressed);
+            pipeline.pushButton(def_.ids[i], pressed, nowUs);
+        }
+    }
+
+private:
+    LadderDef<BUTTONS> def_;
+    volatile uint16_t (&samples_)[SAMPLES];
+    DMAChannel dma_{false};
+    LadderClassifier<BUTTONS> classifier_;
+    Debouncer<BUTTONS> debouncer_;
+};
+
+}  // namespace example
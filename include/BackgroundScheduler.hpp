@@ -0,0 +1,103 @@
+#pragma once
+
+/**
+ * @file BackgroundScheduler.hpp
+ * @brief Background contexts ticked at their own rate, alongside the foreground
+ *
+ * The framework runs one foreground context at a time and routes button
+ * bindings to it. Services that must keep running whatever the active mode
+ * (LED refresh and animation, clock following, persistence) are background
+ * contexts instead: no bindings, just init() and tick() at a fixed period.
+ *
+ * service() is called once per loop() after the foreground update. It runs
+ * the due contexts round-robin and stops as soon as budgetUs is used, so the
+ * background never takes more than one budget (plus one tick) per loop; the
+ * remaining due contexts run first on the next call. A context that fell
+ * more than one period behind is rescheduled from now, without bursts of
+ * catch-up ticks, and counted as late.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Clock.hpp"
+
+namespace example {
+
+class BackgroundContext {
+public:
+    virtual ~BackgroundContext() = default;
+    virtual void init() {}
+    virtual void tick(uint32_t nowUs) = 0;
+    virtual const char* name() const = 0;
+};
+
+/// @tparam MAX_CONTEXTS Registration slots, 12 bytes each; add() fails beyond them
+template <size_t MAX_CONTEXTS = 16>
+class BackgroundScheduler {
+public:
+    explicit BackgroundScheduler(Clock clock) : clock_(clock) {}
+
+    bool add(BackgroundContext& context, uint32_t periodUs) {
+        if (count_ >= MAX_CONTEXTS) return false;
+        entries_[count_++] = {&context, periodUs, 0};
+        return true;
+    }
+
+    /// init() every context, first ticks due immediately
+    void begin() {
+        const uint32_t now = clock_.nowUs();
+        for (size_t i = 0; i < count_; ++i) {
+            entries_[i].context->init();
+            entries_[i].nextUs = now;
+        }
+    }
+
+    /// @return Contexts ticked in this call
+    size_t service(uint32_t budgetUs) {
+        const uint32_t start = clock_.nowUs();
+        uint32_t now = start;
+        size_t ran = 0;
+        for (size_t k = 0; k < count_; ++k) {
+            const size_t i = (cursor_ + k) % count_;
+            Entry& e = entries_[i];
+            if (static_cast<int32_t>(now - e.nextUs) < 0) continue;
+
+            e.context->tick(now);
+            e.nextUs += e.periodUs;
+            if (static_cast<int32_t>(now - e.nextUs) >= 0) {
+                e.nextUs = now + e.periodUs;
+                ++late_;
+            }
+            ++ran;
+            now = clock_.nowUs();
+            if (now - start >= budgetUs) {
+                cursor_ = (i + 1) % count_;
+                return ran;
+            }
+        }
+        return ran;
+    }
+
+    size_t size() const { return count_; }
+    const BackgroundContext& context(size_t i) const { return *entries_[i].context; }
+
+    /// Ticks that ran more than one period late since boot
+    uint32_t late() const { return late_; }
+
+private:
+    struct Entry {
+        BackgroundContext* context;
+        uint32_t periodUs;
+        uint32_t nextUs;
+    };
+
+    Clock clock_;
+    std::array<Entry, MAX_CONTEXTS> entries_{};
+    size_t count_ = 0;
+    size_t cursor_ = 0;
+    uint32_t late_ = 0;
+};
+
+}  // namespace example
@@ -0,0 +1,97 @@
+#pragma once
+
+/**
+ * @file ButtonPanelView.hpp
+ * @brief Button state screen on an ILI9341 driven by ILI9341_T4
+ *
+ * Layout (320x240, landscape): one tile per button, a long-press progress
+ * bar under Button 1 and a toggle lamp under Button 2.
+ *
+ * Refresh never blocks input dispatch:
+ * - handlers only set widget values (RAM)
+ * - service() redraws dirty widgets, then pushes the dirty rectangle with
+ *   updateRegion(); the driver diffs it against the last frame and sends the
+ *   changed pixels by asynchronous DMA
+ * - while a DMA transfer is still running, service() returns immediately and
+ *   the changes are merged into the next push
+ */
+
+#include <ILI9341Driver.h>
+
+#include "DisplayWidgets.hpp"
+
+namespace example {
+
+class ButtonPanelView {
+public:
+    static constexpr int16_t WIDTH = 320;
+    static constexpr int16_t HEIGHT = 240;
+
+    struct Pins {
+        uint8_t cs, dc, sck, mosi, miso, reset;
+    };
+
+    ButtonPanelView(const Pins& pins, uint16_t* framebuffer, uint16_t* internalFramebuffer)
+        : tft_(pins.cs, pins.dc, pins.sck, pins.mosi, pins.miso, pins.reset),
+          canvas_(framebuffer, WIDTH, HEIGHT),
+          internalFramebuffer_(internalFramebuffer) {}
+
+    bool begin(uint32_t spiHz) {
+        if (!tft_.begin(spiHz)) return false;
+        tft_.setRotation(1);
+        tft_.setFramebuffer(internalFramebuffer_);  // Double buffering: update() returns at once
+        tft_.setDiffBuffers(&diff1_, &diff2_);      // Differential updates: only changed pixels
+        tft_.setDiffGap(4);
+        tft_.setRefreshRate(60);
+        tft_.setVSyncSpacing(1);
+
+        canvas_.fill({0, 0, WIDTH - 1, HEIGHT - 1}, color::BLACK);
+        tft_.update(canvas_.pixels(), true);
+        canvas_.takeDirty();
+        ready_ = true;
+        return true;
+    }
+
+    void setPressed(uint8_t button, bool pressed) {
+        if (button == 1) button1_.set(pressed);
+        if (button == 2) button2_.set(pressed);
+    }
+
+    void setToggle(bool on) { toggle_.set(on); }
+    void setLongPressProgress(uint8_t value) { progress_.set(value); }
+
+    /// Redraw dirty widgets and start a DMA push; never waits on the bus
+    void service() {
+        if (!ready_ || tft_.asyncUpdateActive()) return;
+
+        button1_.draw(canvas_);
+        button2_.draw(canvas_);
+        progress_.draw(canvas_);
+        toggle_.draw(canvas_);
+        if (!canvas_.dirty()) return;
+
+        Rect r = canvas_.takeDirty();
+        lastFramePixels_ = r.area();
+        tft_.updateRegion(true, canvas_.pixels() + r.y0 * WIDTH + r.x0,
+                          r.x0, r.x1, r.y0, r.y1, WIDTH);
+    }
+
+    /// Pixels handed to the driver by the last push (before its own diffing)
+    uint32_t lastFramePixels() const { return lastFramePixels_; }
+
+private:
+    ILI9341_T4::ILI9341Driver tft_;
+    ILI9341_T4::DiffBuffStatic<4096> diff1_;
+    ILI9341_T4::DiffBuffStatic<4096> diff2_;
+    Canvas canvas_;
+    uint16_t* internalFramebuffer_;
+    uint32_t lastFramePixels_ = 0;
+    bool ready_ = false;
+
+    IndicatorWidget button1_{{20, 40, 150, 160}, color::GREEN, color::GREY};
+    IndicatorWidget button2_{{170, 40, 300, 160}, color::GREEN, color::GREY};
+    ProgressWidget progress_{{20, 180, 150, 195}, color::ORANGE, color::GREY};
+    IndicatorWidget toggle_{{215, 175, 255, 200}, color::ORANGE, color::BLACK};
+};
+
+}  // namespace example
@@ -0,0 +1,35 @@
+#pragma once
+
+/**
+ * @file Clock.hpp
+ * @brief Microsecond time source passed to whoever needs one
+ *
+ * A function plus a context pointer: it wraps micros() on the device and,
+ * on the host, a virtual clock object per simulated device.
+ *
+ *   Clock::of<micros>()            // plain function
+ *   Clock::from(virtualClock)      // any object with nowUs()
+ */
+
+#include <cstdint>
+
+namespace example {
+
+struct Clock {
+    uint32_t (*read)(void* user) = nullptr;
+    void* user = nullptr;
+
+    uint32_t nowUs() const { return read(user); }
+
+    template <uint32_t (*FN)()>
+    static Clock of() {
+        return {[](void*) { return FN(); }, nullptr};
+    }
+
+    template <typename Source>
+    static Clock from(Source& source) {
+        return {[](void* user) { return static_cast<Source*>(user)->nowUs(); }, &source};
+    }
+};
+
+}  // namespace example
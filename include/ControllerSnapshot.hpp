@@ -0,0 +1,169 @@
+#pragma once
+
+/**
+ * @file ControllerSnapshot.hpp
+ * @brief Context-owned controller values: change diffing and rate-limited bulk resync
+ *
+ * A context registers every controller it drives (channel, CC, priority) and
+ * only ever sets values here; it never sends MIDI itself.
+ *
+ * Live changes: set() marks a bit in a dirty bitset when the value actually
+ * changes. flush(), once per tick, scans the bitset word by word and sends
+ * each dirty controller once with its latest value - repeated sets within a
+ * tick coalesce, unchanged values are never resent.
+ *
+ * Resync: when the host needs the whole state again (DAW reconnect, manual
+ * resync), requestResync() streams all values as one burst, highest
+ * priority first. The burst never competes with live input:
+ * - service() sends at most maxPerBatch messages, at most every intervalUs
+ * - a tick where flush() (or noteInteractive()) sent something holds the
+ *   burst back, so a button press is never queued behind resync traffic
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace example {
+
+/**
+ * @brief Controller table and resync scheduler
+ *
+ * @tparam CAPACITY Maximum number of registered controllers
+ */
+template <size_t CAPACITY>
+class ControllerSnapshot {
+public:
+    using Id = uint16_t;
+    static constexpr Id INVALID = 0xFFFF;
+
+    struct Controller {
+        uint8_t channel;
+        uint8_t cc;
+        uint8_t value;
+        uint8_t priority;  ///< 0 = sent first
+    };
+
+    struct RateLimit {
+        uint8_t maxPerBatch = 4;
+        uint32_t intervalUs = 1000;
+    };
+
+    explicit ControllerSnapshot(RateLimit limit = RateLimit{}) : limit_(limit) {}
+
+    /**
+     * @brief Register a controller (setup time)
+     * @return Id to pass to set(), or INVALID when the table is full
+     */
+    Id add(uint8_t channel, uint8_t cc, uint8_t priority = 0, uint8_t initial = 0) {
+        if (count_ >= CAPACITY) return INVALID;
+        Id id = static_cast<Id>(count_);
+        controllers_[id] = {channel, cc, initial, priority};
+
+        // Keep the send order sorted by priority (stable insertion)
+        size_t pos = count_;
+        while (pos > 0 && controllers_[order_[pos - 1]].priority > priority) {
+            order_[pos] = order_[pos - 1];
+            --pos;
+        }
+        order_[pos] = id;
+        ++count_;
+        return id;
+    }
+
+    /// Update a value; it goes out on the next flush() if it changed
+    void set(Id id, uint8_t value) {
+        if (controllers_[id].value == value) return;
+        controllers_[id].value = value;
+        dirty_[id / 32] |= 1u << (id % 32);
+    }
+    uint8_t value(Id id) const { return controllers_[id].value; }
+    const Controller& controller(Id id) const { return controllers_[id]; }
+
+    /// Id of the controller sending (channel, cc), or INVALID
+    Id find(uint8_t channel, uint8_t cc) const {
+        for (size_t i = 0; i < count_; ++i) {
+            if (controllers_[i].channel == channel && controllers_[i].cc == cc) return static_cast<Id>(i);
+        }
+        return INVALID;
+    }
+    size_t size() const { return count_; }
+
+    /// Visit every controller in send (priority) order
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t i = 0; i < count_; ++i) fn(controllers_[order_[i]]);
+    }
+
+    /**
+     * @brief Send every controller changed since the last flush
+     * @param send Callable (channel, cc, value)
+     * @return Number of messages sent
+     */
+    template <typename Send>
+    size_t flush(Send&& send) {
+        size_t sent = 0;
+        for (size_t w = 0; w < WORDS; ++w) {
+            for (uint32_t bits = dirty_[w]; bits; bits &= bits - 1) {
+                const Controller& c = controllers_[w * 32 + __builtin_ctz(bits)];
+                send(c.channel, c.cc, c.value);
+                ++sent;
+            }
+            dirty_[w] = 0;
+        }
+        if (sent) yield_ = true;
+        return sent;
+    }
+
+    /// Start (or restart) a full resync
+    void requestResync() {
+        cursor_ = 0;
+        active_ = count_ > 0;
+        batchDue_ = true;
+    }
+
+    bool resyncActive() const { return active_; }
+
+    /// An interactive message went out this tick: skip the burst until next tick
+    void noteInteractive() { yield_ = true; }
+
+    /**
+     * @brief Send the next batch of the burst, if due
+     *
+     * Call once per tick, after input dispatch.
+     *
+     * @param nowUs Monotonic time in microseconds
+     * @param send  Callable (channel, cc, value)
+     */
+    template <typename Send>
+    void service(uint32_t nowUs, Send&& send) {
+        bool yield = yield_;
+        yield_ = false;
+        if (!active_ || yield) return;
+        if (!batchDue_ && nowUs - lastBatchUs_ < limit_.intervalUs) return;
+
+        for (uint8_t sent = 0; sent < limit_.maxPerBatch && cursor_ < count_; ++sent) {
+            const Controller& c = controllers_[order_[cursor_++]];
+            send(c.channel, c.cc, c.value);
+        }
+        lastBatchUs_ = nowUs;
+        batchDue_ = false;
+        active_ = cursor_ < count_;
+    }
+
+private:
+    static constexpr size_t WORDS = (CAPACITY + 31) / 32;
+
+    std::array<Controller, CAPACITY> controllers_{};
+    std::array<uint32_t, WORDS> dirty_{};
+    std::array<Id, CAPACITY> order_{};
+    RateLimit limit_;
+    size_t count_ = 0;
+    size_t cursor_ = 0;
+    uint32_t lastBatchUs_ = 0;
+    bool active_ = false;
+    bool batchDue_ = false;
+    bool yield_ = false;
+};
+
+}  // namespace example
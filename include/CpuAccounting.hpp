@@ -0,0 +1,144 @@
+#pragma once
+
+/**
+ * @file CpuAccounting.hpp
+ * @brief Per-context cycle accounting with per-tick budgets and load figures
+ *
+ * Each account (e.g. "main.update", "main.handlers") accumulates the cycles
+ * spent in the scopes measured for it:
+ *
+ *   { auto scope = cpu.measure(ACCOUNT); ... }
+ *
+ * - per tick: spent time is compared to the account budget; code that can
+ *   wait asks overBudget() and defers the rest of its work to a later tick
+ * - per second: load = cycles spent / cycles elapsed, in permille, plus the
+ *   worst tick and the number of ticks over budget
+ *
+ * Cycles come from the trace clock (DWT cycle counter on the Teensy,
+ * steady_clock on the host), so a scope costs two counter reads.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "Trace.hpp"
+
+namespace example {
+
+template <size_t MAX_ACCOUNTS = 8>
+class CpuAccounting {
+public:
+    using Id = uint8_t;
+    static constexpr Id INVALID = 0xFF;
+
+    struct Account {
+        const char* name = "";
+        uint32_t budgetCycles = 0;     ///< Per tick, 0 = unlimited
+        uint32_t tickCycles = 0;       ///< Spent in the current tick
+        uint32_t windowCycles = 0;     ///< Spent in the current window
+        uint32_t maxTickCycles = 0;    ///< Worst tick of the last window
+        uint32_t windowMaxCycles = 0;
+        uint16_t loadPermille = 0;     ///< Share of the last window
+        uint32_t overBudgetTicks = 0;  ///< Since boot
+    };
+
+    class Scope {
+    public:
+        Scope(CpuAccounting& owner, Id id) : owner_(owner), id_(id), start_(Tracer::now()) {}
+        ~Scope() { owner_.charge(id_, Tracer::now() - start_); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        CpuAccounting& owner_;
+        Id id_;
+        uint32_t start_;
+    };
+
+    explicit CpuAccounting(uint32_t windowUs = 1000000) : windowUs_(windowUs) {}
+
+    /// @param budgetUs Per-tick budget (0 = unlimited)
+    Id add(const char* name, uint32_t budgetUs = 0) {
+        if (count_ >= MAX_ACCOUNTS) return INVALID;
+        accounts_[count_].name = name;
+        accounts_[count_].budgetCycles = static_cast<uint32_t>(budgetUs * Tracer::ticksPerUs());
+        return static_cast<Id>(count_++);
+    }
+
+    Scope measure(Id id) { return Scope(*this, id); }
+
+    void charge(Id id, uint32_t cycles) {
+        if (id >= count_ || id >= MAX_ACCOUNTS) return;
+        accounts_[id].tickCycles += cycles;
+    }
+
+    /// Spent so far this tick exceeds the budget: defer what can wait
+    bool overBudget(Id id) const {
+        if (id >= count_ || id >= MAX_ACCOUNTS) return false;
+        const Account& a = accounts_[id];
+        return a.budgetCycles != 0 && a.tickCycles > a.budgetCycles;
+    }
+
+    /// Close the tick: fold tick spend into the window, roll the window when due
+    void endTick(uint32_t nowUs) {
+        for (size_t i = 0; i < count_; ++i) {
+            Account& a = accounts_[i];
+            if (a.budgetCycles != 0 && a.tickCycles > a.budgetCycles) ++a.overBudgetTicks;
+            if (a.tickCycles > a.windowMaxCycles) a.windowMaxCycles = a.tickCycles;
+            a.windowCycles += a.tickCycles;
+            a.tickCycles = 0;
+        }
+
+        const uint32_t elapsedUs = nowUs - windowStartUs_;
+        if (elapsedUs < windowUs_) return;
+        const double windowCycles = elapsedUs * Tracer::ticksPerUs();
+        for (size_t i = 0; i < count_; ++i) {
+            Account& a = accounts_[i];
+            a.loadPermille = static_cast<uint16_t>(a.windowCycles * 1000.0 / windowCycles);
+            a.maxTickCycles = a.windowMaxCycles;
+            a.windowCycles = 0;
+            a.windowMaxCycles = 0;
+        }
+        windowStartUs_ = nowUs;
+    }
+
+    size_t size() const { return count_; }
+    const Account& account(Id id) const { return accounts_[id]; }
+    uint16_t loadPermille(Id id) const { return accounts_[id].loadPermille; }
+
+    /// Sum of over-budget ticks over all accounts (cheap change detection)
+    uint32_t overBudgetTicks() const {
+        uint32_t total = 0;
+        for (size_t i = 0; i < count_; ++i) total += accounts_[i].overBudgetTicks;
+        return total;
+    }
+
+    /**
+     * @brief One line per account: name, load %, worst tick, budget, overruns
+     * @param out Needs write(const char*, size_t) (e.g. Serial)
+     */
+    template <typename Out>
+    void print(Out& out) const {
+        char line[96];
+        const double perUs = Tracer::ticksPerUs();
+        for (size_t i = 0; i < count_; ++i) {
+            const Account& a = accounts_[i];
+            const int n = snprintf(line, sizeof(line), "%-14s %3u.%u%%  max %6lu us  budget %6lu us  over %lu\n",
+                                   a.name, a.loadPermille / 10, a.loadPermille % 10,
+                                   static_cast<unsigned long>(a.maxTickCycles / perUs),
+                                   static_cast<unsigned long>(a.budgetCycles / perUs),
+                                   static_cast<unsigned long>(a.overBudgetTicks));
+            if (n > 0) out.write(line, static_cast<size_t>(n < int(sizeof(line)) ? n : int(sizeof(line)) - 1));
+        }
+    }
+
+private:
+    std::array<Account, MAX_ACCOUNTS> accounts_{};
+    size_t count_ = 0;
+    uint32_t windowUs_;
+    uint32_t windowStartUs_ = 0;
+};
+
+}  // namespace example
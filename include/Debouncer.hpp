@@ -0,0 +1,56 @@
+#pragma once
+
+/**
+ * @file Debouncer.hpp
+ * @brief Time-based debouncing of up to 32 binary inputs held in one bitmask
+ *
+ * A level change is accepted once the raw input has kept it for windowUs.
+ * Only the bits currently bouncing or settling are visited, so a quiet
+ * panel costs two XORs per update whatever the number of inputs.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace example {
+
+template <size_t N>
+class Debouncer {
+    static_assert(N > 0 && N <= 32, "Debouncer handles 1 to 32 inputs");
+
+public:
+    explicit Debouncer(uint32_t windowUs) : windowUs_(windowUs) {}
+
+    /**
+     * @brief Feed one raw sample
+     * @param raw   Bit i = input i active
+     * @return Bits whose debounced state changed on this call
+     */
+    uint32_t update(uint32_t raw, uint32_t nowUs) {
+        uint32_t flipped = raw ^ candidate_;
+        candidate_ = raw;
+        for (uint32_t bits = flipped; bits; bits &= bits - 1) {
+            since_[__builtin_ctz(bits)] = nowUs;
+        }
+
+        uint32_t changed = 0;
+        for (uint32_t bits = candidate_ ^ stable_; bits; bits &= bits - 1) {
+            const uint32_t i = __builtin_ctz(bits);
+            if (nowUs - since_[i] >= windowUs_) changed |= 1u << i;
+        }
+        stable_ ^= changed;
+        return changed;
+    }
+
+    /// Debounced state, bit i = input i active
+    uint32_t state() const { return stable_; }
+
+private:
+    uint32_t windowUs_;
+    uint32_t candidate_ = 0;
+    uint32_t stable_ = 0;
+    std::array<uint32_t, N> since_{};
+};
+
+}  // namespace example
@@ -0,0 +1,181 @@
+#pragma once
+
+/**
+ * @file DisplayWidgets.hpp
+ * @brief Minimal retained-mode widgets drawing into an RGB565 framebuffer
+ *
+ * Widgets redraw only when their value changes, and every redraw grows the
+ * canvas dirty rectangle. The display driver then pushes just that rectangle,
+ * so an idle screen costs nothing and a button press costs one small region.
+ *
+ * Nothing here touches hardware: the same code renders on the host.
+ */
+
+#include <algorithm>
+#include <cstdint>
+
+namespace example {
+
+/// RGB565 helpers
+namespace color {
+    constexpr uint16_t rgb(uint8_t r, uint8_t g, uint8_t b) {
+        return static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+    }
+    constexpr uint16_t BLACK = rgb(0, 0, 0);
+    constexpr uint16_t GREY = rgb(64, 64, 64);
+    constexpr uint16_t WHITE = rgb(255, 255, 255);
+    constexpr uint16_t GREEN = rgb(0, 200, 80);
+    constexpr uint16_t ORANGE = rgb(255, 140, 0);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Rect / Canvas
+// ═══════════════════════════════════════════════════════════════════════════
+
+/// Inclusive pixel rectangle; empty when x1 < x0
+struct Rect {
+    int16_t x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+
+    bool empty() const { return x1 < x0 || y1 < y0; }
+    uint32_t area() const { return empty() ? 0 : uint32_t(x1 - x0 + 1) * uint32_t(y1 - y0 + 1); }
+
+    void merge(const Rect& other) {
+        if (other.empty()) return;
+        if (empty()) { *this = other; return; }
+        x0 = std::min(x0, other.x0);
+        y0 = std::min(y0, other.y0);
+        x1 = std::max(x1, other.x1);
+        y1 = std::max(y1, other.y1);
+    }
+};
+
+/**
+ * @brief Framebuffer view with dirty-rectangle accumulation
+ */
+class Canvas {
+public:
+    Canvas(uint16_t* pixels, int16_t width, int16_t height)
+        : pixels_(pixels), width_(width), height_(height) {}
+
+    void fill(const Rect& r, uint16_t rgb565) {
+        Rect c = clip(r);
+        if (c.empty()) return;
+        for (int16_t y = c.y0; y <= c.y1; ++y) {
+            std::fill(pixels_ + y * width_ + c.x0, pixels_ + y * width_ + c.x1 + 1, rgb565);
+        }
+        dirty_.merge(c);
+    }
+
+    /// 1-pixel outline
+    void frame(const Rect& r, uint16_t rgb565) {
+        fill({r.x0, r.y0, r.x1, r.y0}, rgb565);
+        fill({r.x0, r.y1, r.x1, r.y1}, rgb565);
+        fill({r.x0, r.y0, r.x0, r.y1}, rgb565);
+        fill({r.x1, r.y0, r.x1, r.y1}, rgb565);
+    }
+
+    bool dirty() const { return !dirty_.empty(); }
+
+    /// Return the accumulated dirty region and start a new frame
+    Rect takeDirty() {
+        Rect d = dirty_;
+        dirty_ = Rect{};
+        return d;
+    }
+
+    uint16_t* pixels() const { return pixels_; }
+    int16_t width() const { return width_; }
+    int16_t height() const { return height_; }
+
+private:
+    Rect clip(const Rect& r) const {
+        return {std::max<int16_t>(r.x0, 0), std::max<int16_t>(r.y0, 0),
+                std::min<int16_t>(r.x1, width_ - 1), std::min<int16_t>(r.y1, height_ - 1)};
+    }
+
+    uint16_t* pixels_;
+    int16_t width_;
+    int16_t height_;
+    Rect dirty_;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Widgets
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Two-state filled box (button pressed, toggle on)
+ */
+class IndicatorWidget {
+public:
+    IndicatorWidget(Rect bounds, uint16_t onColor, uint16_t offColor)
+        : bounds_(bounds), onColor_(onColor), offColor_(offColor) {}
+
+    void set(bool on) {
+        if (on == on_) return;
+        on_ = on;
+        dirty_ = true;
+    }
+
+    void invalidate() { dirty_ = true; }
+
+    void draw(Canvas& canvas) {
+        if (!dirty_) return;
+        canvas.fill(bounds_, on_ ? onColor_ : offColor_);
+        canvas.frame(bounds_, color::WHITE);
+        dirty_ = false;
+    }
+
+private:
+    Rect bounds_;
+    uint16_t onColor_;
+    uint16_t offColor_;
+    bool on_ = false;
+    bool dirty_ = true;
+};
+
+/**
+ * @brief Horizontal bar, value 0..255
+ *
+ * Only the span between the old and new fill edge is repainted.
+ */
+class ProgressWidget {
+public:
+    ProgressWidget(Rect bounds, uint16_t fillColor, uint16_t backColor)
+        : bounds_(bounds), fillColor_(fillColor), backColor_(backColor) {}
+
+    /// The last value set before draw() wins, even when it is back at the drawn edge
+    void set(uint8_t value) { pendingEdge_ = edgeFor(value); }
+
+    void invalidate() { full_ = true; }
+
+    void draw(Canvas& canvas) {
+        if (full_) {
+            canvas.fill(bounds_, backColor_);
+            edge_ = bounds_.x0 - 1;
+            full_ = false;
+        }
+        if (pendingEdge_ == edge_) return;
+        if (pendingEdge_ > edge_) {
+            canvas.fill({int16_t(edge_ + 1), bounds_.y0, pendingEdge_, bounds_.y1}, fillColor_);
+        } else {
+            canvas.fill({int16_t(pendingEdge_ + 1), bounds_.y0, edge_, bounds_.y1}, backColor_);
+        }
+        edge_ = pendingEdge_;
+    }
+
+private:
+    int16_t edgeFor(uint8_t value) const {
+        int32_t span = bounds_.x1 - bounds_.x0 + 1;
+        return static_cast<int16_t>(bounds_.x0 - 1 + (span * value) / 255);
+    }
+
+    Rect bounds_;
+    uint16_t fillColor_;
+    uint16_t backColor_;
+    int16_t edge_ = 0;
+    int16_t pendingEdge_ = bounds_.x0 - 1;
+    bool full_ = true;
+};
+
+}  // namespace example
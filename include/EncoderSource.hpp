@@ -0,0 +1,48 @@
+#pragma once
+
+/**
+ * @file EncoderSource.hpp
+ * @brief Quadrature encoder feeding the InputPipeline
+ *
+ * The Encoder library counts edges in its pin interrupts; poll() only reads
+ * the accumulated count and turns whole detents into TURN events, stamped
+ * with the same clock as button events.
+ */
+
+#include <Encoder.h>
+
+#include <cstdint>
+
+namespace example {
+
+struct EncoderDef {
+    uint8_t id;
+    uint8_t pinA;
+    uint8_t pinB;
+    uint8_t pushButtonId;   ///< ButtonDef id of the shaft switch (0 = none)
+    uint8_t countsPerStep;  ///< Quadrature counts per detent (usually 4)
+};
+
+class EncoderSource {
+public:
+    explicit EncoderSource(const EncoderDef& def) : def_(def), encoder_(def.pinA, def.pinB) {}
+
+    template <typename Pipeline>
+    void poll(Pipeline& pipeline, uint32_t nowUs) {
+        int32_t steps = (encoder_.read() - consumed_) / def_.countsPerStep;
+        if (steps == 0) return;
+        if (steps > 127) steps = 127;
+        if (steps < -127) steps = -127;
+        consumed_ += steps * def_.countsPerStep;
+        pipeline.pushEncoder(def_.id, static_cast<int8_t>(steps), nowUs);
+    }
+
+    const EncoderDef& def() const { return def_; }
+
+private:
+    EncoderDef def_;
+    Encoder encoder_;
+    int32_t consumed_ = 0;
+};
+
+}  // namespace example
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file FsrSource.hpp
+ * @brief Force-sensitive pads on ADC2: press/release plus pressure events
+ *
+ * ADC1 belongs to the resistor ladder (continuous DMA), so FSR pads are
+ * converted on ADC2, one pad at a time and split across ticks: poll()
+ * collects the finished conversion, starts the next pad's conversion and
+ * returns. It never waits on the ADC.
+ *
+ * Each result goes through a PressureFilter. Edges reach the pipeline as
+ * ordinary PRESS/RELEASE events (gestures, toggles and actions work
+ * unchanged); pressure goes out as PRESSURE events, already smoothed,
+ * dead-banded and rate-limited.
+ */
+
+#include <Arduino.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "PressureFilter.hpp"
+#include "Trace.hpp"
+
+namespace example {
+
+struct FsrPad {
+    uint8_t id;
+    uint8_t pin;
+    uint8_t adc2Channel;  ///< ADC2 input of the pin (see the i.MX RT1062 pin table)
+};
+
+template <size_t N>
+class FsrSource : public Traced {
+public:
+    FsrSource(const std::array<FsrPad, N>& pads, PressureFilter::Tuning tuning = {})
+        : pads_(pads) {
+        for (PressureFilter& f : filters_) f = PressureFilter(tuning);
+    }
+
+    /// Call after any analogReadResolution() (ADC2 shares the ADC1 setup)
+    void begin() {
+        for (const FsrPad& pad : pads_) pinMode(pad.pin, INPUT_DISABLE);
+        ADC2_HC0 = pads_[0].adc2Channel;
+    }
+
+    template <typename Pipeline>
+    void poll(Pipeline& pipeline, uint32_t nowUs) {
+        if (!(ADC2_HS & ADC_HS_COCO0)) return;
+        const uint16_t raw = static_cast<uint16_t>(ADC2_R0);  // Reading R0 clears COCO0
+
+        const size_t i = current_;
+        current_ = (current_ + 1) % N;
+        ADC2_HC0 = pads_[current_].adc2Channel;
+
+        const PressureFilter::Output out = filters_[i].update(raw, nowUs);
+        if (out.edge && out.pressed) {
+            EX_TRACE_INSTANT(tracer_, "fsr", pads_[i].id, 1);
+            pipeline.pushButton(pads_[i].id, true, nowUs);
+        }
+        if (out.hasPressure) pipeline.pushPressure(pads_[i].id, out.pressure, nowUs);
+        if (out.edge && !out.pressed) {
+            EX_TRACE_INSTANT(tracer_, "fsr", pads_[i].id, 0);
+            pipeline.pushButton(pads_[i].id, false, nowUs);
+        }
+    }
+
+private:
+    std::array<FsrPad, N> pads_;
+    std::array<PressureFilter, N> filters_{};
+    size_t current_ = 0;
+};
+
+}  // namespace example
@@ -0,0 +1,170 @@
+#pragma once
+
+/**
+ * @file GpioButtonSource.hpp
+ * @brief Port-grouped GPIO button scan feeding the InputPipeline
+ *
+ * The pin list is a constexpr table (Config::BUTTON_PINS). Every pin is
+ * resolved to its fast-GPIO port and bit at compile time (teensy41::gpioOf),
+ * and pins sharing a port are grouped into a constexpr scan plan, so a scan
+ * is one 32-bit PSR read per port - at a constant address - followed by bit
+ * extraction. No digitalRead(), no table lookup at run time.
+ *
+ * Edges are debounced, stamped with the scan time and pushed into the same
+ * pipeline as encoder events, which also resolves the gestures: these pins
+ * are not registered with the framework, so nothing else scans them.
+ *
+ * Register access goes through the Gpio parameter (FastGpio on the Teensy),
+ * so the scan runs as is on the host against simulated ports.
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Debouncer.hpp"
+#include "Trace.hpp"
+
+namespace example {
+
+struct ButtonPin {
+    uint8_t id;
+    uint8_t pin;
+    bool activeLow;
+};
+
+namespace teensy41 {
+
+/// Fast GPIO port (6..9) and bit of a pin
+struct GpioBit {
+    uint8_t port;
+    uint8_t bit;
+};
+
+constexpr uint8_t PIN_COUNT = 55;
+
+/// Pins 0..54 as mapped by the Teensy 4.1 core (core_pins.h CORE_PINn_PINREG / CORE_PINn_BIT)
+constexpr GpioBit GPIO_MAP[PIN_COUNT] = {
+    {6, 3},  {6, 2},  {9, 4},  {9, 5},  {9, 6},  {9, 8},  {7, 10}, {7, 17},  // 0-7
+    {7, 16}, {7, 11}, {7, 0},  {7, 2},  {7, 1},  {7, 3},  {6, 18}, {6, 19},  // 8-15
+    {6, 23}, {6, 22}, {6, 17}, {6, 16}, {6, 26}, {6, 27}, {6, 24}, {6, 25},  // 16-23
+    {6, 12}, {6, 13}, {6, 30}, {6, 31}, {8, 18}, {9, 31}, {8, 23}, {8, 22},  // 24-31
+    {7, 12}, {9, 7},  {7, 29}, {7, 28}, {7, 18}, {7, 19}, {6, 28}, {6, 29},  // 32-39
+    {6, 20}, {6, 21}, {8, 15}, {8, 14}, {8, 13}, {8, 12}, {8, 17}, {8, 16},  // 40-47
+    {9, 24}, {9, 27}, {9, 28}, {9, 22}, {9, 26}, {9, 25}, {9, 29},           // 48-54
+};
+
+constexpr GpioBit gpioOf(uint8_t pin) { return GPIO_MAP[pin]; }
+
+/// GPIO6..GPIO9 PSR (pad status) register addresses
+constexpr uint32_t psrAddress(uint8_t port) { return 0x42000000u + (port - 6u) * 0x4000u + 0x08u; }
+
+}  // namespace teensy41
+
+#ifdef ARDUINO
+/// Teensy 4.1 register access: PSR read at a compile-time address
+struct FastGpio {
+    static void configure(uint8_t pin, bool activeLow) { pinMode(pin, activeLow ? INPUT_PULLUP : INPUT_PULLDOWN); }
+
+    template <uint8_t PORT>
+    static uint32_t read() {
+        return *reinterpret_cast<volatile uint32_t*>(teensy41::psrAddress(PORT));
+    }
+};
+#endif
+
+/**
+ * @brief Scan + debounce for the buttons of PINS
+ *
+ * @tparam N    Number of buttons (32 max)
+ * @tparam PINS Constexpr pin table with static storage
+ * @tparam Gpio configure(pin, activeLow) and read<PORT>() (FastGpio on the Teensy)
+ */
+template <size_t N, const std::array<ButtonPin, N>& PINS, typename Gpio
+#ifdef ARDUINO
+          = FastGpio
+#endif
+          >
+class GpioButtonSource : public Traced {
+    static_assert(N > 0 && N <= 32, "GpioButtonSource scans 1 to 32 buttons");
+
+    /// Ports read per scan, and where each button's bit is
+    struct Plan {
+        std::array<uint8_t, 4> ports{};  ///< Distinct ports, in first-use order
+        size_t portCount = 0;
+        std::array<uint8_t, N> slotOf{};  ///< Index into ports
+        std::array<uint8_t, N> bitOf{};
+        uint32_t invert = 0;
+        bool valid = true;
+    };
+
+    static constexpr Plan makePlan() {
+        Plan plan;
+        for (size_t i = 0; i < N; ++i) {
+            if (PINS[i].pin >= teensy41::PIN_COUNT) {
+                plan.valid = false;
+                continue;
+            }
+            const teensy41::GpioBit g = teensy41::gpioOf(PINS[i].pin);
+            size_t slot = 0;
+            while (slot < plan.portCount && plan.ports[slot] != g.port) ++slot;
+            if (slot == plan.portCount) plan.ports[plan.portCount++] = g.port;
+            plan.slotOf[i] = static_cast<uint8_t>(slot);
+            plan.bitOf[i] = g.bit;
+            if (PINS[i].activeLow) plan.invert |= 1u << i;
+        }
+        return plan;
+    }
+
+    static constexpr Plan PLAN = makePlan();
+    static_assert(PLAN.valid, "Button pin out of range (Teensy 4.1: 0..54)");
+
+public:
+    explicit GpioButtonSource(uint32_t debounceUs) : debouncer_(debounceUs) {}
+
+    void begin() {
+        for (const ButtonPin& p : PINS) Gpio::configure(p.pin, p.activeLow);
+    }
+
+    /// One read per GPIO port; bit i = button i pressed
+    uint32_t scan() const {
+        std::array<uint32_t, 4> levels{};
+        readPorts<0>(levels);
+        uint32_t raw = 0;
+        for (size_t i = 0; i < N; ++i) {
+            raw |= ((levels[PLAN.slotOf[i]] >> PLAN.bitOf[i]) & 1u) << i;
+        }
+        return raw ^ PLAN.invert;
+    }
+
+    /// Ports read per scan (for tests and benchmarks)
+    static constexpr size_t portReads() { return PLAN.portCount; }
+
+    template <typename Pipeline>
+    void poll(Pipeline& pipeline, uint32_t nowUs) {
+        const uint32_t changed = debouncer_.update(scan(), nowUs);
+        for (uint32_t bits = changed; bits; bits &= bits - 1) {
+            const uint32_t i = __builtin_ctz(bits);
+            const bool pressed = (debouncer_.state() >> i) & 1u;
+            EX_TRACE_INSTANT(tracer_, "edge", PINS[i].id, pressed);
+            pipeline.pushButton(PINS[i].id, pressed, nowUs);
+        }
+    }
+
+private:
+    template <size_t SLOT>
+    static void readPorts(std::array<uint32_t, 4>& levels) {
+        if constexpr (SLOT < PLAN.portCount) {
+            levels[SLOT] = Gpio::template read<PLAN.ports[SLOT]>();
+            readPorts<SLOT + 1>(levels);
+        }
+    }
+
+    Debouncer<N> debouncer_;
+};
+
+}  // namespace example
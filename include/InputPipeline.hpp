@@ -0,0 +1,386 @@
+#pragma once
+
+/**
+ * @file InputPipeline.hpp
+ * @brief One timestamped event stream for buttons and encoders
+ *
+ * Every input source pushes compact 8-byte events into the same ring queue,
+ * stamped with the same microsecond clock. dispatch() drains the queue once
+ * per tick and resolves each event against one flat binding table:
+ *
+ *   button edge ──┐
+ *   pad pressure ─┤
+ *   encoder push ─┼──> [ InputEvent queue ] ──> dispatch() ──> bindings
+ *   encoder turn ─┘
+ *
+ * Binding keys are packed in a contiguous array scanned linearly, and
+ * handlers live in fixed inline storage: no heap, no virtual calls.
+ *
+ * Gestures are resolved here too, from the same timestamps, so a button has
+ * one resolver whatever it is bound to:
+ * - long press: emitted once per hold, longPressUs after the press (checked
+ *   against the event times and against dispatch()'s nowUs)
+ * - double tap: a press within doubleTapUs of the previous press; the tap
+ *   pair is consumed, so a third press starts a new pair
+ * Gesture events follow the press they belong to, in the same pass.
+ *
+ * Modifier gestures ("hold Button 1 and turn the encoder") are plain
+ * bindings carrying a required held-button mask:
+ *
+ *   input.onButton(1).held().onEncoder(1).turn().then(...)
+ *
+ * The pipeline keeps the held buttons in one bitmask, so a modifier check
+ * is a single AND. Bindings are kept sorted by specificity at bind time:
+ * for a given event only the most specific satisfied bindings run, and
+ * the fine-adjust binding replaces the plain one while Button 1 is down.
+ *
+ * PRESS and RELEASE are always delivered when they happen, so a button
+ * can be a modifier and a momentary control at once. Once a modifier
+ * binding has run during a hold, the hold was a modifier hold: its
+ * LONG_PRESS is swallowed, and modifyingMask() reports it until release.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#include "Trace.hpp"
+
+namespace example {
+
+// ═══════════════════════════════════════════════════════════════════════════
+// InputEvent
+// ═══════════════════════════════════════════════════════════════════════════
+
+enum class InputSource : uint8_t { BUTTON = 0, ENCODER = 1 };
+enum class InputType : uint8_t { PRESS = 0, RELEASE = 1, TURN = 2, PRESSURE = 3, LONG_PRESS = 4, DOUBLE_TAP = 5 };
+
+struct InputEvent {
+    uint32_t timeUs;
+    InputSource source;
+    InputType type;
+    uint8_t id;
+    int8_t delta;  ///< Encoder steps (TURN) or pressure 0..127 (PRESSURE)
+};
+static_assert(sizeof(InputEvent) == 8, "InputEvent must stay 8 bytes");
+
+/// Gesture thresholds, shared by every button of a pipeline
+struct GestureTiming {
+    uint32_t longPressUs = 500000;
+    uint32_t doubleTapUs = 300000;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// InputCallback
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Type-erased handler with inline storage
+ *
+ * Accepts lambdas taking `()` or `(const InputEvent&)` whose captures fit in
+ * two pointers (typically `[this]`).
+ */
+class InputCallback {
+public:
+    static constexpr size_t STORAGE = 2 * sizeof(void*);
+
+    InputCallback() = default;
+
+    template <typename F>
+    InputCallback(F fn) {  // NOLINT: implicit by design, mirrors then(lambda)
+        static_assert(sizeof(F) <= STORAGE, "Handler captures too much: capture `this` only");
+        static_assert(std::is_trivially_copyable_v<F>, "Handler must be trivially copyable");
+        new (storage_) F(fn);
+        invoke_ = [](void* storage, const InputEvent& event) {
+            F& f = *static_cast<F*>(storage);
+            if constexpr (std::is_invocable_v<F&, const InputEvent&>) {
+                f(event);
+            } else {
+                f();
+            }
+        };
+    }
+
+    explicit operator bool() const { return invoke_ != nullptr; }
+    void operator()(const InputEvent& event) { invoke_(storage_, event); }
+
+private:
+    alignas(void*) unsigned char storage_[STORAGE]{};
+    void (*invoke_)(void*, const InputEvent&) = nullptr;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// InputPipeline
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Shared event queue and binding resolver
+ *
+ * @tparam QUEUE_SIZE   Event capacity (power of two)
+ * @tparam MAX_BINDINGS Binding table capacity
+ */
+template <size_t QUEUE_SIZE, size_t MAX_BINDINGS>
+class InputPipeline : public Traced {
+    static_assert((QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0, "QUEUE_SIZE must be a power of two");
+
+public:
+    explicit InputPipeline(GestureTiming timing = GestureTiming{}) : timing_(timing) {}
+
+    class Trigger {
+    public:
+        Trigger(InputPipeline& pipeline, uint16_t key, uint32_t heldMask)
+            : pipeline_(pipeline), key_(key), heldMask_(heldMask) {}
+        bool then(InputCallback handler) { return pipeline_.bind(key_, heldMask_, handler); }
+
+    private:
+        InputPipeline& pipeline_;
+        uint16_t key_;
+        uint32_t heldMask_;
+    };
+
+    class Modifier;
+
+    class ButtonBuilder {
+    public:
+        ButtonBuilder(InputPipeline& pipeline, uint8_t id, uint32_t heldMask)
+            : pipeline_(pipeline), id_(id), heldMask_(heldMask) {}
+        Trigger press() { return {pipeline_, keyOf(InputSource::BUTTON, InputType::PRESS, id_), heldMask_}; }
+        Trigger release() { return {pipeline_, keyOf(InputSource::BUTTON, InputType::RELEASE, id_), heldMask_}; }
+        /// Pressure updates of a force-sensitive pad (event.delta = 0..127)
+        Trigger pressure() { return {pipeline_, keyOf(InputSource::BUTTON, InputType::PRESSURE, id_), heldMask_}; }
+        Trigger longPress() { return {pipeline_, keyOf(InputSource::BUTTON, InputType::LONG_PRESS, id_), heldMask_}; }
+        Trigger doubleTap() { return {pipeline_, keyOf(InputSource::BUTTON, InputType::DOUBLE_TAP, id_), heldMask_}; }
+        /// Use this button as a modifier for the binding that follows
+        Modifier held() { return {pipeline_, heldMask_ | bitOf(id_)}; }
+
+    private:
+        InputPipeline& pipeline_;
+        uint8_t id_;
+        uint32_t heldMask_;
+    };
+
+    class EncoderBuilder {
+    public:
+        EncoderBuilder(InputPipeline& pipeline, uint8_t id, uint32_t heldMask)
+            : pipeline_(pipeline), id_(id), heldMask_(heldMask) {}
+        Trigger turn() { return {pipeline_, keyOf(InputSource::ENCODER, InputType::TURN, id_), heldMask_}; }
+
+    private:
+        InputPipeline& pipeline_;
+        uint8_t id_;
+        uint32_t heldMask_;
+    };
+
+    /// Held-button state collected so far: onButton(1).held().onEncoder(1)...
+    class Modifier {
+    public:
+        Modifier(InputPipeline& pipeline, uint32_t heldMask) : pipeline_(pipeline), heldMask_(heldMask) {}
+        ButtonBuilder onButton(uint8_t id) { return {pipeline_, id, heldMask_}; }
+        EncoderBuilder onEncoder(uint8_t id) { return {pipeline_, id, heldMask_}; }
+
+    private:
+        InputPipeline& pipeline_;
+        uint32_t heldMask_;
+    };
+
+    ButtonBuilder onButton(uint8_t id) { return {*this, id, 0}; }
+    EncoderBuilder onEncoder(uint8_t id) { return {*this, id, 0}; }
+
+    // ───────────────────────────────────────────────────────────────────────
+    // Producers
+    // ───────────────────────────────────────────────────────────────────────
+
+    void pushButton(uint8_t id, bool pressed, uint32_t timeUs) {
+        push({timeUs, InputSource::BUTTON, pressed ? InputType::PRESS : InputType::RELEASE, id, 0});
+    }
+
+    void pushPressure(uint8_t id, uint8_t pressure, uint32_t timeUs) {
+        push({timeUs, InputSource::BUTTON, InputType::PRESSURE, id, static_cast<int8_t>(pressure & 0x7F)});
+    }
+
+    void pushEncoder(uint8_t id, int8_t delta, uint32_t timeUs) {
+        if (delta == 0) return;
+        push({timeUs, InputSource::ENCODER, InputType::TURN, id, delta});
+    }
+
+    // ───────────────────────────────────────────────────────────────────────
+    // Consumer
+    // ───────────────────────────────────────────────────────────────────────
+
+    /**
+     * @brief Drain the queue: one pass, every event resolved against the binding table
+     * @param nowUs Same clock as the event stamps; long presses mature against it
+     * @return Number of queued events processed (gesture events not counted)
+     */
+    size_t dispatch(uint32_t nowUs) {
+        return dispatch(nowUs, [](const InputEvent&) {});
+    }
+
+    /// Same, then hand each event to visit() (e.g. a declarative action table)
+    template <typename Visitor>
+    size_t dispatch(uint32_t nowUs, Visitor&& visit) {
+        const size_t processed = head_ - tail_;
+        while (tail_ != head_) {
+            const InputEvent event = queue_[tail_ & MASK];
+            ++tail_;
+            if (event.source != InputSource::BUTTON || event.id >= 32) {
+                deliver(event, visit);
+                continue;
+            }
+            const uint32_t bit = bitOf(event.id);
+            if (event.type == InputType::PRESS) {
+                heldMask_ |= bit;
+                longFired_ &= ~bit;
+                swallowed_ &= ~bit;
+                pressedAtUs_[event.id] = event.timeUs;
+                deliver(event, visit);
+                resolveTap(event, visit);
+            } else if (event.type == InputType::RELEASE) {
+                matureLongPress(event.id, event.timeUs, visit);
+                heldMask_ &= ~bit;
+                swallowed_ &= ~bit;
+                deliver(event, visit);
+            } else {
+                deliver(event, visit);
+            }
+        }
+        for (uint32_t bits = heldMask_ & ~longFired_; bits; bits &= bits - 1) {
+            matureLongPress(static_cast<uint8_t>(__builtin_ctz(bits)), nowUs, visit);
+        }
+        return processed;
+    }
+
+    /**
+     * @brief Hooks around every handler (time attribution, profiling)
+     * @param enter Called before the handler, with its binding key
+     * @param leave Called after it, so the visitor and the next events are
+     *              not charged to that binding
+     */
+    void setHandlerProbe(void (*enter)(void* user, uint16_t key), void (*leave)(void* user), void* user) {
+        probeEnter_ = enter;
+        probeLeave_ = leave;
+        probeUser_ = user;
+    }
+
+    /// Buttons currently held, bit n = button id n
+    uint32_t heldMask() const { return heldMask_; }
+
+    /// Held buttons that have acted as a modifier during this hold
+    uint32_t modifyingMask() const { return swallowed_; }
+
+    /// Press time of the current (or last) hold of a button
+    uint32_t pressedAtUs(uint8_t id) const { return id < 32 ? pressedAtUs_[id] : 0; }
+
+    size_t pending() const { return head_ - tail_; }
+    uint32_t dropped() const { return dropped_; }
+    size_t highWater() const { return highWater_; }
+
+private:
+    static constexpr size_t MASK = QUEUE_SIZE - 1;
+
+    static constexpr uint16_t keyOf(InputSource source, InputType type, uint8_t id) {
+        return static_cast<uint16_t>((uint16_t(source) << 12) | (uint16_t(type) << 8) | id);
+    }
+
+    static constexpr uint32_t bitOf(uint8_t id) { return id < 32 ? (1u << id) : 0; }
+
+    /// Run the bindings for one event, then the visitor
+    template <typename Visitor>
+    void deliver(const InputEvent& event, Visitor& visit) {
+        // Bindings are sorted by specificity: once one is satisfied,
+        // only those with the same specificity may still run
+        const uint16_t key = keyOf(event.source, event.type, event.id);
+        int8_t matched = -1;
+        for (size_t i = 0; i < bindingCount_; ++i) {
+            if (keys_[i] != key || (heldMask_ & masks_[i]) != masks_[i]) continue;
+            if (matched >= 0 && specificity_[i] != matched) break;
+            matched = specificity_[i];
+            // The buttons a modifier binding relies on lose their long press
+            swallowed_ |= masks_[i];
+            EX_TRACE_SCOPE(tracer_, "handler");
+            if (probeEnter_) probeEnter_(probeUser_, key);
+            handlers_[i](event);
+            if (probeLeave_) probeLeave_(probeUser_);
+        }
+        visit(event);
+    }
+
+    /// Fire the long press of a held button once it has been held long enough by atUs
+    template <typename Visitor>
+    void matureLongPress(uint8_t id, uint32_t atUs, Visitor& visit) {
+        const uint32_t bit = bitOf(id);
+        if (!(heldMask_ & bit) || (longFired_ & bit)) return;
+        if (atUs - pressedAtUs_[id] < timing_.longPressUs) return;
+        longFired_ |= bit;
+        if (swallowed_ & bit) return;
+        deliver({pressedAtUs_[id] + timing_.longPressUs, InputSource::BUTTON, InputType::LONG_PRESS, id, 0}, visit);
+    }
+
+    /// A press within doubleTapUs of an unpaired press completes a double tap
+    template <typename Visitor>
+    void resolveTap(const InputEvent& press, Visitor& visit) {
+        const uint32_t bit = bitOf(press.id);
+        if ((tapArmed_ & bit) && press.timeUs - lastTapUs_[press.id] <= timing_.doubleTapUs) {
+            tapArmed_ &= ~bit;
+            deliver({press.timeUs, InputSource::BUTTON, InputType::DOUBLE_TAP, press.id, 0}, visit);
+            return;
+        }
+        tapArmed_ |= bit;
+        lastTapUs_[press.id] = press.timeUs;
+    }
+
+    /// Insert after every binding that is at least as specific (stable)
+    bool bind(uint16_t key, uint32_t heldMask, InputCallback handler) {
+        if (bindingCount_ >= MAX_BINDINGS || !handler) return false;
+        const int8_t specificity = static_cast<int8_t>(__builtin_popcount(heldMask));
+        size_t pos = bindingCount_;
+        while (pos > 0 && specificity_[pos - 1] < specificity) {
+            keys_[pos] = keys_[pos - 1];
+            masks_[pos] = masks_[pos - 1];
+            specificity_[pos] = specificity_[pos - 1];
+            handlers_[pos] = handlers_[pos - 1];
+            --pos;
+        }
+        keys_[pos] = key;
+        masks_[pos] = heldMask;
+        specificity_[pos] = specificity;
+        handlers_[pos] = handler;
+        ++bindingCount_;
+        return true;
+    }
+
+    void push(const InputEvent& event) {
+        if (head_ - tail_ >= QUEUE_SIZE) {
+            ++dropped_;
+            return;
+        }
+        queue_[head_ & MASK] = event;
+        ++head_;
+        if (head_ - tail_ > highWater_) highWater_ = head_ - tail_;
+    }
+
+    std::array<InputEvent, QUEUE_SIZE> queue_{};
+    std::array<uint16_t, MAX_BINDINGS> keys_{};
+    std::array<uint32_t, MAX_BINDINGS> masks_{};
+    std::array<int8_t, MAX_BINDINGS> specificity_{};
+    std::array<InputCallback, MAX_BINDINGS> handlers_{};
+    size_t bindingCount_ = 0;
+    GestureTiming timing_;
+    std::array<uint32_t, 32> pressedAtUs_{};
+    std::array<uint32_t, 32> lastTapUs_{};
+    uint32_t heldMask_ = 0;
+    uint32_t longFired_ = 0;
+    uint32_t tapArmed_ = 0;
+    uint32_t swallowed_ = 0;  ///< Holds used as a modifier: long press dropped
+    void (*probeEnter_)(void*, uint16_t) = nullptr;
+    void (*probeLeave_)(void*) = nullptr;
+    void* probeUser_ = nullptr;
+    size_t head_ = 0;
+    size_t tail_ = 0;
+    size_t highWater_ = 0;
+    uint32_t dropped_ = 0;
+};
+
+}  // namespace example
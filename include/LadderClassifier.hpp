@@ -0,0 +1,89 @@
+#pragma once
+
+/**
+ * @file LadderClassifier.hpp
+ * @brief Voltage-band classification for resistor-ladder buttons
+ *
+ * Each button pulls the ladder output to its own voltage. Bands are given
+ * by their center (ADC counts), sorted or not, plus the idle reading.
+ *
+ * - a new key is the band (or idle) whose center is nearest to the sample:
+ *   no dead zones, every band is reachable however close its neighbours
+ * - the current key is held while the sample stays within its hold range:
+ *   on each side, the boundary with the nearest neighbour (mid-gap) plus
+ *   the hysteresis
+ *
+ *   so a reading hovering on a boundary keeps the key it came from instead
+ *   of chattering between two buttons. The hysteresis is capped at a
+ *   quarter gap: a reading at a neighbour's center always switches.
+ *
+ * Pure integer code: no hardware, runs as is on the host.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace example {
+
+template <size_t BANDS>
+class LadderClassifier {
+public:
+    static constexpr uint8_t NONE = 0xFF;
+
+    /**
+     * @param centers    Expected ADC reading per button (index = band)
+     * @param idle       Reading with no button pressed (treated as one more band)
+     * @param hysteresis Counts a held key extends past each boundary
+     */
+    constexpr LadderClassifier(const std::array<uint16_t, BANDS>& centers, uint16_t idle, uint16_t hysteresis)
+        : centers_(centers), idle_(idle) {
+        for (size_t b = 0; b <= BANDS; ++b) {
+            const uint16_t center = b < BANDS ? centers_[b] : idle_;
+            uint16_t below = center;  // Gap to the nearest neighbour on each side
+            uint16_t above = static_cast<uint16_t>(0xFFFF - center);
+            for (size_t o = 0; o <= BANDS; ++o) {
+                const uint16_t other = o < BANDS ? centers_[o] : idle_;
+                if (o == b) continue;
+                if (other < center && center - other < below) below = static_cast<uint16_t>(center - other);
+                if (other > center && other - center < above) above = static_cast<uint16_t>(other - center);
+            }
+            lows_[b] = static_cast<uint16_t>(center - reach(below, hysteresis));
+            highs_[b] = static_cast<uint16_t>(center + reach(above, hysteresis));
+        }
+    }
+
+    /// Band index of the pressed button, NONE when idle
+    uint8_t classify(uint16_t sample) {
+        const size_t held = current_ == NONE ? BANDS : current_;
+        if (sample >= lows_[held] && sample <= highs_[held]) return current_;
+
+        uint8_t nearest = NONE;
+        uint16_t best = distance(sample, idle_);
+        for (size_t b = 0; b < BANDS; ++b) {
+            if (distance(sample, centers_[b]) < best) {
+                best = distance(sample, centers_[b]);
+                nearest = static_cast<uint8_t>(b);
+            }
+        }
+        current_ = nearest;
+        return current_;
+    }
+
+private:
+    static constexpr uint16_t distance(uint16_t a, uint16_t b) { return a > b ? a - b : b - a; }
+
+    /// How far a held key extends toward a neighbour gap counts away
+    static constexpr uint16_t reach(uint16_t gap, uint16_t hysteresis) {
+        const uint16_t cap = gap / 4;
+        return static_cast<uint16_t>(gap / 2 + (hysteresis < cap ? hysteresis : cap));
+    }
+
+    std::array<uint16_t, BANDS> centers_;
+    uint16_t idle_;
+    std::array<uint16_t, BANDS + 1> lows_{};   ///< Hold range per band, idle last
+    std::array<uint16_t, BANDS + 1> highs_{};
+    uint8_t current_ = NONE;
+};
+
+}  // namespace example
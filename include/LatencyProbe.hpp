@@ -0,0 +1,171 @@
+#pragma once
+
+/**
+ * @file LatencyProbe.hpp
+ * @brief Round-trip MIDI latency measured by the device itself
+ *
+ * The device sends timestamped SysEx probes; the host sends each one back
+ * unchanged (tools/latency_echo.py). The echo's arrival time minus the
+ * timestamp it carries is the round trip, measured on the device clock
+ * alone, so no clock sync is needed. One-way latency is estimated as half
+ * the round trip (symmetric link assumption).
+ *
+ *   start:  F0 7D 03 12 <count> F7            host -> device
+ *   probe:  F0 7D 03 10 <seq> <t0..t4> F7     device -> host -> device
+ *   report: F0 7D 03 11 <LatencyReport, 7-bit packed> F7
+ *
+ * One probe is in flight at a time; a probe not echoed within timeoutUs is
+ * counted as lost. Round trips are kept raw (up to MAX_SAMPLES) and sorted
+ * once, when the report is built.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Metrics.hpp"
+
+namespace example {
+
+/// Fixed wire layout: append new fields at the end and bump VERSION
+struct LatencyReport {
+    static constexpr uint16_t VERSION = 1;
+
+    uint16_t version = VERSION;
+    uint16_t size = sizeof(LatencyReport);
+    uint32_t sent = 0;
+    uint32_t received = 0;
+    uint32_t lost = 0;
+    uint32_t minUs = 0;
+    uint32_t p50Us = 0;
+    uint32_t p90Us = 0;
+    uint32_t p99Us = 0;
+    uint32_t maxUs = 0;
+    uint32_t meanUs = 0;
+    uint32_t oneWayP50Us = 0;  ///< p50 / 2
+};
+
+template <size_t MAX_SAMPLES = 256>
+class LatencyProbe {
+public:
+    static constexpr uint8_t SYSEX_PROBE = 0x10;
+    static constexpr uint8_t SYSEX_REPORT = 0x11;
+    static constexpr uint8_t SYSEX_START = 0x12;
+    static constexpr size_t PROBE_SIZE = 11;
+    static constexpr size_t REPORT_MAX = sysExSize(sizeof(LatencyReport));
+
+    LatencyProbe(uint32_t intervalUs, uint32_t timeoutUs) : intervalUs_(intervalUs), timeoutUs_(timeoutUs) {}
+
+    void start(uint32_t count) {
+        *this = LatencyProbe(intervalUs_, timeoutUs_);
+        remaining_ = count;
+        running_ = count > 0;
+    }
+
+    bool running() const { return running_; }
+
+    /// Start requests carry the probe count (0 = 100)
+    static bool isStart(const uint8_t* data, size_t size, uint32_t& count) {
+        const uint8_t* body = payload(data, size, SYSEX_START);
+        if (!body) return false;
+        count = (size > 0 && body[0] != 0xF7 && body[0] != 0) ? body[0] : 100;
+        return true;
+    }
+
+    /**
+     * @brief Send the next probe when due, expire a lost one
+     * @param send Callable (const uint8_t* data, size_t size)
+     * @return true when the run just finished (report() is ready)
+     */
+    template <typename Send>
+    bool service(uint32_t nowUs, Send&& send) {
+        if (!running_) return false;
+        if (inFlight_ && nowUs - sentAtUs_ >= timeoutUs_) {
+            inFlight_ = false;
+            ++report_.lost;
+            seq_ = static_cast<uint8_t>((seq_ + 1) & 0x7F);  // A late echo no longer matches
+        }
+        if (inFlight_ || nowUs - sentAtUs_ < intervalUs_) return false;
+
+        if (remaining_ == 0) {
+            running_ = false;
+            finish();
+            return true;
+        }
+
+        uint8_t msg[PROBE_SIZE] = {0xF0, Metrics::SYSEX_MANUFACTURER, Metrics::SYSEX_DEVICE, SYSEX_PROBE, seq_};
+        for (size_t i = 0; i < 5; ++i) msg[5 + i] = static_cast<uint8_t>((nowUs >> (7 * i)) & 0x7F);
+        msg[10] = 0xF7;
+        send(msg, sizeof(msg));
+
+        sentAtUs_ = nowUs;
+        inFlight_ = true;
+        --remaining_;
+        ++report_.sent;
+        return false;
+    }
+
+    /// An incoming SysEx (with or without F0): true if it was one of our probes
+    bool onEcho(const uint8_t* data, size_t size, uint32_t nowUs) {
+        const uint8_t* body = payload(data, size, SYSEX_PROBE);
+        if (!body || size < 6) return false;
+        if (!inFlight_ || body[0] != seq_) return true;  // Late echo of a lost probe
+
+        uint32_t sentUs = 0;
+        for (size_t i = 0; i < 5; ++i) sentUs |= uint32_t(body[1 + i] & 0x7F) << (7 * i);
+        if (count_ < MAX_SAMPLES) samples_[count_++] = nowUs - sentUs;
+        ++report_.received;
+        inFlight_ = false;
+        seq_ = static_cast<uint8_t>((seq_ + 1) & 0x7F);
+        return true;
+    }
+
+    const LatencyReport& report() const { return report_; }
+
+    /// F0 7D 03 11 <report> F7 into out (REPORT_MAX bytes)
+    size_t encodeReport(uint8_t* out) const {
+        return Metrics::encodeSysEx(SYSEX_REPORT, &report_, sizeof(report_), out);
+    }
+
+private:
+    /// Bytes after the command when the header matches (size becomes their count), else null
+    static const uint8_t* payload(const uint8_t* data, size_t& size, uint8_t command) {
+        if (size > 0 && data[0] == 0xF0) { ++data; --size; }
+        if (size < 3 || data[0] != Metrics::SYSEX_MANUFACTURER || data[1] != Metrics::SYSEX_DEVICE
+            || data[2] != command) {
+            return nullptr;
+        }
+        size -= 3;
+        return data + 3;
+    }
+
+    void finish() {
+        if (count_ == 0) return;
+        std::sort(samples_.begin(), samples_.begin() + count_);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count_; ++i) sum += samples_[i];
+        report_.minUs = samples_[0];
+        report_.maxUs = samples_[count_ - 1];
+        report_.p50Us = percentile(50);
+        report_.p90Us = percentile(90);
+        report_.p99Us = percentile(99);
+        report_.meanUs = static_cast<uint32_t>(sum / count_);
+        report_.oneWayP50Us = report_.p50Us / 2;
+    }
+
+    uint32_t percentile(size_t p) const { return samples_[(count_ - 1) * p / 100]; }
+
+    std::array<uint32_t, MAX_SAMPLES> samples_{};
+    LatencyReport report_;
+    uint32_t intervalUs_;
+    uint32_t timeoutUs_;
+    uint32_t sentAtUs_ = 0;
+    uint32_t remaining_ = 0;
+    size_t count_ = 0;
+    uint8_t seq_ = 0;
+    bool inFlight_ = false;
+    bool running_ = false;
+};
+
+}  // namespace example
@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * @file LedBank.hpp
+ * @brief Button LED state in RAM, flushed once per tick with BAM dimming
+ *
+ * Handlers only write brightness values into an array. flush(), called once
+ * per tick, pushes the whole bank to the bus in one transfer - and only when
+ * the bits to show differ from what the bus already latched.
+ *
+ * Dimming is Binary Angle Modulation: brightness is split into BITS bit
+ * planes, plane b is shown for unitUs << b. Planes are rebuilt only when a
+ * level changed, so a tick costs one time compare and one byte compare.
+ * LEDs that are fully on or off give identical planes: a static on/off
+ * panel causes no bus traffic at all.
+ *
+ * Planes advance on flush(), so plane times are rounded up to the tick:
+ * pick unitUs at least as long as a typical loop tick.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace example {
+
+/**
+ * @tparam N    Number of LEDs (bit i of the bus bytes = LED i)
+ * @tparam BITS Brightness resolution (top BITS bits of the 0..255 level)
+ */
+template <size_t N, size_t BITS = 4>
+class LedBank {
+    static_assert(BITS >= 1 && BITS <= 8, "BITS must be 1..8");
+
+public:
+    static constexpr size_t BYTES = (N + 7) / 8;
+
+    explicit LedBank(uint32_t unitUs) : unitUs_(unitUs) {}
+
+    /// RAM only: safe and cheap from any handler
+    void set(size_t led, uint8_t level) {
+        if (led >= N || levels_[led] == level) return;
+        levels_[led] = level;
+        dirty_ = true;
+    }
+
+    void setOn(size_t led, bool on) { set(led, on ? 255 : 0); }
+    uint8_t get(size_t led) const { return levels_[led]; }
+
+    /**
+     * @brief Advance BAM and write the bank if the visible bits changed
+     * @param bus Needs write(const uint8_t* bytes, size_t count)
+     * @return true if a bus transfer happened
+     */
+    template <typename Bus>
+    bool flush(Bus& bus, uint32_t nowUs) {
+        if (dirty_) rebuild();
+        if (nowUs - planeStartUs_ >= (unitUs_ << plane_)) {
+            plane_ = (plane_ + 1) % BITS;
+            planeStartUs_ = nowUs;
+        }
+
+        const std::array<uint8_t, BYTES>& bits = planes_[plane_];
+        if (latched_ && std::memcmp(bits.data(), shown_.data(), BYTES) == 0) return false;
+        bus.write(bits.data(), BYTES);
+        shown_ = bits;
+        latched_ = true;
+        ++transfers_;
+        return true;
+    }
+
+    /// Bus transfers since boot (one per tick at most)
+    uint32_t transfers() const { return transfers_; }
+
+private:
+    void rebuild() {
+        for (auto& plane : planes_) plane.fill(0);
+        for (size_t led = 0; led < N; ++led) {
+            const uint8_t top = static_cast<uint8_t>(levels_[led] >> (8 - BITS));
+            for (size_t b = 0; b < BITS; ++b) {
+                if (top & (1u << b)) planes_[b][led / 8] |= static_cast<uint8_t>(1u << (led % 8));
+            }
+        }
+        dirty_ = false;
+    }
+
+    std::array<uint8_t, N> levels_{};
+    std::array<std::array<uint8_t, BYTES>, BITS> planes_{};
+    std::array<uint8_t, BYTES> shown_{};
+    uint32_t unitUs_;
+    uint32_t planeStartUs_ = 0;
+    uint32_t transfers_ = 0;
+    uint8_t plane_ = 0;
+    bool dirty_ = false;
+    bool latched_ = false;
+};
+
+}  // namespace example
@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * @file LedBus.hpp
+ * @brief Bus backends for LedBank: 74HC595 chain over SPI, or GPIO ports
+ *
+ * Both take the packed LED bits (bit i = LED i) in one write() call:
+ * - ShiftRegisterBus: one SPI transaction for the whole chain, then a latch
+ *   pulse, so all LEDs change together (no flicker from partial updates).
+ *   The 595 has no data output, but SPI begin() still claims a MISO pin:
+ *   misoPin moves it off pins in use (SPI1 defaults to pin 1, Serial1 TX)
+ * - GpioLedBus: set/clear masks are built per GPIO port, then written with
+ *   one DR_SET and one DR_CLEAR store per port instead of one
+ *   digitalWrite() per pin
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace example {
+
+class ShiftRegisterBus {
+public:
+    ShiftRegisterBus(SPIClass& spi, uint8_t latchPin, uint8_t misoPin, uint32_t spiHz)
+        : spi_(spi), latchPin_(latchPin), misoPin_(misoPin), settings_(spiHz, MSBFIRST, SPI_MODE0) {}
+
+    void begin() {
+        pinMode(latchPin_, OUTPUT);
+        digitalWriteFast(latchPin_, LOW);
+        spi_.setMISO(misoPin_);
+        spi_.begin();
+    }
+
+    /// The last byte shifted stays in the first register: bytes[0] (LEDs 0-7) goes out last
+    void write(const uint8_t* bytes, size_t count) {
+        spi_.beginTransaction(settings_);
+        for (size_t i = count; i-- > 0;) spi_.transfer(bytes[i]);
+        spi_.endTransaction();
+        digitalWriteFast(latchPin_, HIGH);
+        digitalWriteFast(latchPin_, LOW);
+    }
+
+private:
+    SPIClass& spi_;
+    uint8_t latchPin_;
+    uint8_t misoPin_;
+    SPISettings settings_;
+};
+
+/**
+ * @tparam N    Number of LEDs, one pin each (active high)
+ * @tparam PINS Constexpr pin table with static storage
+ */
+template <size_t N, const std::array<uint8_t, N>& PINS>
+class GpioLedBus {
+public:
+    void begin() {
+        for (size_t i = 0; i < N; ++i) {
+            pinMode(PINS[i], OUTPUT);
+            digitalWriteFast(PINS[i], LOW);
+
+            volatile uint32_t* set = portSetRegister(PINS[i]);
+            size_t port = 0;
+            while (port < portCount_ && setRegs_[port] != set) ++port;
+            if (port == portCount_) {
+                setRegs_[portCount_] = set;
+                clearRegs_[portCount_] = portClearRegister(PINS[i]);
+                ++portCount_;
+            }
+            portOf_[i] = static_cast<uint8_t>(port);
+            maskOf_[i] = digitalPinToBitMask(PINS[i]);
+        }
+    }
+
+    void write(const uint8_t* bytes, size_t count) {
+        std::array<uint32_t, N> set{};
+        std::array<uint32_t, N> clear{};
+        for (size_t i = 0; i < N && i / 8 < count; ++i) {
+            if (bytes[i / 8] & (1u << (i % 8))) set[portOf_[i]] |= maskOf_[i];
+            else clear[portOf_[i]] |= maskOf_[i];
+        }
+        for (size_t port = 0; port < portCount_; ++port) {
+            *setRegs_[port] = set[port];
+            *clearRegs_[port] = clear[port];
+        }
+    }
+
+private:
+    std::array<volatile uint32_t*, N> setRegs_{};
+    std::array<volatile uint32_t*, N> clearRegs_{};
+    std::array<uint8_t, N> portOf_{};
+    std::array<uint32_t, N> maskOf_{};
+    size_t portCount_ = 0;
+};
+
+}  // namespace example
@@ -0,0 +1,153 @@
+#pragma once
+
+/**
+ * @file LoopMonitor.hpp
+ * @brief Loop period jitter histogram, overrun capture and hardware watchdog
+ *
+ * Wraps each loop() iteration:
+ *
+ *   monitor.beginTick();
+ *   app->update();          // code inside marks stages: monitor.stage("display")
+ *   monitor.endTick();
+ *
+ * - period between ticks goes into a log2 histogram (bucket n: [2^n, 2^(n+1)) us)
+ * - a tick longer than the threshold is an overrun: the slowest stage of
+ *   that tick (name + argument, e.g. the binding key) is kept for inspection
+ * - endTick() feeds the hardware watchdog, so a hard hang resets the board
+ *   instead of leaving dead buttons
+ */
+
+#include <array>
+#include <cstdint>
+
+#include "Clock.hpp"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+namespace example {
+
+class LoopMonitor {
+public:
+    static constexpr uint8_t BUCKETS = 16;  ///< Last bucket collects >= 32 ms
+
+    struct Overrun {
+        uint32_t tickUs = 0;       ///< Total tick duration
+        const char* stage = "";    ///< Slowest stage in that tick
+        uint16_t stageArg = 0;
+        uint32_t stageUs = 0;
+        uint32_t count = 0;        ///< Overruns since boot
+    };
+
+    LoopMonitor(Clock clock, uint32_t thresholdUs)
+        : clock_(clock), thresholdUs_(thresholdUs) {}
+
+    void beginTick() {
+        const uint32_t now = clock_.nowUs();
+        if (tickStart_ != 0) histogram_[bucketOf(now - tickStart_)]++;
+        tickStart_ = now;
+        stageName_ = "app";
+        stageArg_ = 0;
+        stageStart_ = now;
+        slowest_ = {};
+    }
+
+    /// Close the running stage and open a new one
+    void stage(const char* name, uint16_t arg = 0) {
+        const uint32_t now = clock_.nowUs();
+        closeStage(now);
+        stageName_ = name;
+        stageArg_ = arg;
+        stageStart_ = now;
+    }
+
+    void endTick() {
+        const uint32_t now = clock_.nowUs();
+        closeStage(now);
+        const uint32_t tickUs = now - tickStart_;
+        if (tickUs > maxTickUs_) maxTickUs_ = tickUs;
+        if (tickUs >= thresholdUs_) {
+            overrun_.tickUs = tickUs;
+            overrun_.stage = slowest_.name;
+            overrun_.stageArg = slowest_.arg;
+            overrun_.stageUs = slowest_.us;
+            overrun_.count++;
+        }
+#ifdef ARDUINO
+        if (watchdogEnabled_) feedWatchdog();
+#endif
+    }
+
+    const std::array<uint32_t, BUCKETS>& periodHistogram() const { return histogram_; }
+    const Overrun& lastOverrun() const { return overrun_; }
+    uint32_t maxTickUs() const { return maxTickUs_; }
+
+#ifdef ARDUINO
+    /**
+     * @brief Arm RTWDOG (WDOG3) on the 32 kHz LPO clock
+     *
+     * Must be fed at least every timeoutMs (max ~2 s); endTick() does it.
+     */
+    void enableWatchdog(uint32_t timeoutMs) {
+        uint32_t ticks = timeoutMs * 32;
+        if (ticks > 0xFFFF) ticks = 0xFFFF;
+        __disable_irq();
+        RTWDOG_CNT = 0xD928C520;  // Unlock sequence
+        while (!(RTWDOG_CS & RTWDOG_CS_ULK)) {}
+        RTWDOG_TOVAL = ticks;
+        RTWDOG_WIN = 0;
+        RTWDOG_CS = RTWDOG_CS_CMD32EN | RTWDOG_CS_CLK(1) | RTWDOG_CS_UPDATE | RTWDOG_CS_EN;
+        while (!(RTWDOG_CS & RTWDOG_CS_RCS)) {}
+        __enable_irq();
+        watchdogEnabled_ = true;
+    }
+
+    static void feedWatchdog() { RTWDOG_CNT = 0xB480A602; }
+
+    /**
+     * @brief True when the last reset came from the watchdog
+     *
+     * SRC_SRSR flags are sticky across resets and write-1-to-clear: the flag
+     * is cleared here, so that a later reset of another kind does not report
+     * it again. Call once at boot.
+     */
+    static bool resetByWatchdog() {
+        const bool watchdog = (SRC_SRSR & SRC_SRSR_WDOG3_RST_B) != 0;
+        if (watchdog) SRC_SRSR = SRC_SRSR_WDOG3_RST_B;
+        return watchdog;
+    }
+#endif
+
+private:
+    struct Stage {
+        const char* name = "";
+        uint16_t arg = 0;
+        uint32_t us = 0;
+    };
+
+    static uint8_t bucketOf(uint32_t us) {
+        uint8_t b = 0;
+        while (us > 1 && b < BUCKETS - 1) { us >>= 1; ++b; }
+        return b;
+    }
+
+    void closeStage(uint32_t now) {
+        const uint32_t us = now - stageStart_;
+        if (us >= slowest_.us) slowest_ = {stageName_, stageArg_, us};
+    }
+
+    Clock clock_;
+    uint32_t thresholdUs_;
+    std::array<uint32_t, BUCKETS> histogram_{};
+    Overrun overrun_;
+    Stage slowest_;
+    const char* stageName_ = "";
+    uint16_t stageArg_ = 0;
+    uint32_t stageStart_ = 0;
+    uint32_t tickStart_ = 0;
+    uint32_t maxTickUs_ = 0;
+    bool watchdogEnabled_ = false;
+};
+
+}  // namespace example
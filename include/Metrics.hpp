@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * @file Metrics.hpp
+ * @brief Always-on runtime counters with a SysEx query/response
+ *
+ * Independent of OC_LOG: counters are plain relaxed atomics, a few cycles
+ * each, and the block is read out over MIDI on request:
+ *
+ *   query:    F0 7D 03 01 F7
+ *   response: F0 7D 03 02 <MetricsBlock, 7-bit packed> F7
+ *
+ * The same header carries the other host commands of this example, e.g.
+ *
+ *   resync:   F0 7D 03 03 F7   (resend every controller value)
+ *
+ * 0x7D is the MIDI non-commercial manufacturer ID, 0x03 this example.
+ * Packing: every 7 bytes become 8, the first carrying the high bits.
+ * tools/metrics_reader.py sends the query and prints the decoded block.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace example {
+
+/// Fixed wire layout: append new fields at the end and bump VERSION
+struct MetricsBlock {
+    static constexpr uint16_t VERSION = 2;
+
+    uint16_t version = VERSION;
+    uint16_t size = sizeof(MetricsBlock);
+    uint32_t uptimeMs = 0;
+    uint32_t eventsTotal = 0;
+    uint32_t eventsPerSecond = 0;
+    uint32_t droppedEvents = 0;
+    uint32_t queueHighWater = 0;
+    uint32_t maxLoopUs = 0;
+    uint32_t midiBytesSent = 0;
+    uint32_t midiQueueMaxUs = 0;   ///< v2: longest write-to-commit delay
+    uint32_t midiQueueMeanUs = 0;  ///< v2: mean write-to-commit delay
+};
+
+/// Largest message Metrics::encodeSysEx() writes for a block of size bytes
+constexpr size_t sysExSize(size_t size) { return 4 + (size * 8 + 6) / 7 + 1; }
+
+class Metrics {
+public:
+    static constexpr uint8_t SYSEX_MANUFACTURER = 0x7D;
+    static constexpr uint8_t SYSEX_DEVICE = 0x03;
+    static constexpr uint8_t SYSEX_QUERY = 0x01;
+    static constexpr uint8_t SYSEX_RESPONSE = 0x02;
+    static constexpr uint8_t SYSEX_RESYNC = 0x03;
+
+    /// Largest response: header (4) + packed block + F7
+    static constexpr size_t RESPONSE_MAX = sysExSize(sizeof(MetricsBlock));
+
+    void countEvents(uint32_t n) { events_.fetch_add(n, std::memory_order_relaxed); }
+    void countMidiBytes(uint32_t n) { midiBytes_.fetch_add(n, std::memory_order_relaxed); }
+
+    /// Absolute values owned elsewhere (e.g. the input queue)
+    void setDropped(uint32_t n) { dropped_.store(n, std::memory_order_relaxed); }
+    void setQueueHighWater(uint32_t n) { highWater_.store(n, std::memory_order_relaxed); }
+    void setMidiQueueDelay(uint32_t maxUs, uint32_t meanUs) {
+        midiQueueMaxUs_.store(maxUs, std::memory_order_relaxed);
+        midiQueueMeanUs_.store(meanUs, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Call once per loop iteration
+     *
+     * Tracks the longest gap between calls and refreshes the events/s rate
+     * once per second.
+     */
+    void tick(uint32_t nowUs) {
+        if (lastTickUs_ != 0) {
+            uint32_t period = nowUs - lastTickUs_;
+            if (period > maxLoopUs_.load(std::memory_order_relaxed)) {
+                maxLoopUs_.store(period, std::memory_order_relaxed);
+            }
+        }
+        lastTickUs_ = nowUs;
+
+        if (nowUs - rateWindowUs_ >= 1000000) {
+            uint32_t total = events_.load(std::memory_order_relaxed);
+            eventsPerSecond_.store(total - rateBase_, std::memory_order_relaxed);
+            rateBase_ = total;
+            rateWindowUs_ = nowUs;
+        }
+    }
+
+    MetricsBlock snapshot(uint32_t uptimeMs) const {
+        MetricsBlock b;
+        b.uptimeMs = uptimeMs;
+        b.eventsTotal = events_.load(std::memory_order_relaxed);
+        b.eventsPerSecond = eventsPerSecond_.load(std::memory_order_relaxed);
+        b.droppedEvents = dropped_.load(std::memory_order_relaxed);
+        b.queueHighWater = highWater_.load(std::memory_order_relaxed);
+        b.maxLoopUs = maxLoopUs_.load(std::memory_order_relaxed);
+        b.midiBytesSent = midiBytes_.load(std::memory_order_relaxed);
+        b.midiQueueMaxUs = midiQueueMaxUs_.load(std::memory_order_relaxed);
+        b.midiQueueMeanUs = midiQueueMeanUs_.load(std::memory_order_relaxed);
+        return b;
+    }
+
+    /// True for F0 7D 03 01 F7 (with or without the F0/F7 framing)
+    static bool isQuery(const uint8_t* data, size_t size) { return isCommand(data, size, SYSEX_QUERY); }
+
+    /// True for F0 7D 03 <command> ... (with or without the F0/F7 framing)
+    static bool isCommand(const uint8_t* data, size_t size, uint8_t command) {
+        if (size > 0 && data[0] == 0xF0) { ++data; --size; }
+        return size >= 3 && data[0] == SYSEX_MANUFACTURER && data[1] == SYSEX_DEVICE
+            && data[2] == command;
+    }
+
+    /**
+     * @brief Build the complete response message (F0 ... F7)
+     * @return Bytes written to out (RESPONSE_MAX at most)
+     */
+    static size_t encodeResponse(const MetricsBlock& block, uint8_t* out) {
+        return encodeSysEx(SYSEX_RESPONSE, &block, sizeof(block), out);
+    }
+
+    /**
+     * @brief F0 7D 03 <command> <block, 7-bit packed> F7
+     * @return Bytes written to out (sysExSize(size) at most)
+     */
+    static size_t encodeSysEx(uint8_t command, const void* block, size_t size, uint8_t* out) {
+        const uint8_t* raw = static_cast<const uint8_t*>(block);
+
+        size_t n = 0;
+        out[n++] = 0xF0;
+        out[n++] = SYSEX_MANUFACTURER;
+        out[n++] = SYSEX_DEVICE;
+        out[n++] = command;
+        for (size_t i = 0; i < size; i += 7) {
+            size_t chunk = size - i < 7 ? size - i : 7;
+            uint8_t& msbs = out[n++];
+            msbs = 0;
+            for (size_t j = 0; j < chunk; ++j) {
+                msbs |= static_cast<uint8_t>((raw[i + j] >> 7) << j);
+                out[n++] = raw[i + j] & 0x7F;
+            }
+        }
+        out[n++] = 0xF7;
+        return n;
+    }
+
+private:
+    std::atomic<uint32_t> events_{0};
+    std::atomic<uint32_t> eventsPerSecond_{0};
+    std::atomic<uint32_t> dropped_{0};
+    std::atomic<uint32_t> highWater_{0};
+    std::atomic<uint32_t> maxLoopUs_{0};
+    std::atomic<uint32_t> midiBytes_{0};
+    std::atomic<uint32_t> midiQueueMaxUs_{0};
+    std::atomic<uint32_t> midiQueueMeanUs_{0};
+    uint32_t lastTickUs_ = 0;
+    uint32_t rateWindowUs_ = 0;
+    uint32_t rateBase_ = 0;
+};
+
+}  // namespace example
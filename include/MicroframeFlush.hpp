@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * @file MicroframeFlush.hpp
+ * @brief Commit USB-MIDI output once per 125 us microframe, measure queueing delay
+ *
+ * On high-speed USB the host sees new data at most once per microframe.
+ * Committing several times inside one microframe only splits messages over
+ * extra transactions; leaving data to the driver's flush timer adds up to
+ * a frame of jitter. The policy here:
+ *
+ *   - at most one commit per microframe: pending output is committed on
+ *     the first tick that sees a new microframe index (USB1_FRINDEX). This
+ *     is a rate limit, not a deadline - output written after that commit
+ *     waits for the first tick of a later microframe, so its delay is up to
+ *     one microframe plus one tick (a slow tick stretches it)
+ *   - the time from the first pending write to its commit is recorded in
+ *     a log2 histogram (bucket n: [2^n, 2^(n+1)) us), with max and mean
+ *
+ * The microframe index is passed in, so the policy runs as is on the host
+ * against a simulated SOF counter.
+ */
+
+#include <array>
+#include <cstdint>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+namespace example {
+
+#ifdef ARDUINO
+/// Current USB frame/microframe index (frame << 3 | microframe)
+inline uint16_t usbMicroframe() { return static_cast<uint16_t>(USB1_FRINDEX & 0x3FFF); }
+#endif
+
+class MicroframeFlush {
+public:
+    static constexpr uint8_t BUCKETS = 12;  ///< Last bucket collects >= 2 ms
+
+    /// Output was written (only the first write of a batch is timed)
+    void noteWrite(uint32_t nowUs) {
+        if (pending_) return;
+        pending_ = true;
+        oldestUs_ = nowUs;
+    }
+
+    /// True when output is pending and this microframe has no commit yet
+    bool mayCommit(uint16_t microframe) const { return pending_ && microframe != lastMicroframe_; }
+
+    bool pending() const { return pending_; }
+
+    /// The batch was committed
+    void committed(uint16_t microframe, uint32_t nowUs) {
+        const uint32_t delay = nowUs - oldestUs_;
+        histogram_[bucketOf(delay)]++;
+        if (delay > maxDelayUs_) maxDelayUs_ = delay;
+        totalDelayUs_ += delay;
+        ++commits_;
+        lastMicroframe_ = microframe;
+        pending_ = false;
+    }
+
+    const std::array<uint32_t, BUCKETS>& delayHistogram() const { return histogram_; }
+    uint32_t maxDelayUs() const { return maxDelayUs_; }
+    uint32_t meanDelayUs() const { return commits_ ? static_cast<uint32_t>(totalDelayUs_ / commits_) : 0; }
+    uint32_t commits() const { return commits_; }
+
+private:
+    static uint8_t bucketOf(uint32_t us) {
+        uint8_t b = 0;
+        while (us > 1 && b < BUCKETS - 1) { us >>= 1; ++b; }
+        return b;
+    }
+
+    std::array<uint32_t, BUCKETS> histogram_{};
+    uint64_t totalDelayUs_ = 0;
+    uint32_t maxDelayUs_ = 0;
+    uint32_t commits_ = 0;
+    uint32_t oldestUs_ = 0;
+    uint16_t lastMicroframe_ = 0xFFFF;
+    bool pending_ = false;
+};
+
+}  // namespace example
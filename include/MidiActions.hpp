@@ -0,0 +1,133 @@
+#pragma once
+
+/**
+ * @file MidiActions.hpp
+ * @brief Declarative button-to-MIDI actions as POD records
+ *
+ * Most bindings are one of a few shapes ("press sends CC 127, release sends
+ * CC 0"). Instead of one lambda each, they are declared as 6-byte records:
+ *
+ *   constexpr std::array<MidiAction, 2> ACTIONS = {{
+ *       momentaryCC(1, 0, 20),        // button 1: CC 20 = 127 / 0
+ *       sendCC(3, 0, 22, 64),         // button 3: CC 22 = 64 on press
+ *   }};
+ *
+ * Pressure ops (AFTERTOUCH, PRESSURE_CC) follow the PRESSURE events of
+ * force-sensitive pads; every other op ignores them.
+ *
+ * The table is contiguous, has no capture storage and can be serialized
+ * as is. run() is a tight loop over it with a switch on the opcode; the
+ * resulting messages go to a sink, so the table never touches drivers.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "InputPipeline.hpp"
+
+namespace example {
+
+enum class ActionOp : uint8_t {
+    SEND_CC = 0,       ///< Press: CC number = value
+    MOMENTARY_CC = 1,  ///< Press: CC = 127, release: CC = 0
+    TOGGLE_CC = 2,     ///< Press: CC flips between 0 and 127
+    NOTE = 3,          ///< Press: note on (value = velocity), release: note off
+    AFTERTOUCH = 4,    ///< Pressure: polyphonic aftertouch on note number
+    PRESSURE_CC = 5,   ///< Pressure: CC number = pressure
+};
+
+struct MidiAction {
+    uint8_t button;
+    ActionOp op;
+    uint8_t channel;
+    uint8_t number;  ///< CC or note number
+    uint8_t value;   ///< CC value or velocity
+    uint8_t state;   ///< Runtime state (TOGGLE_CC: current value)
+};
+static_assert(sizeof(MidiAction) == 6, "MidiAction must stay 6 bytes");
+
+constexpr MidiAction sendCC(uint8_t button, uint8_t channel, uint8_t cc, uint8_t value) {
+    return {button, ActionOp::SEND_CC, channel, cc, value, 0};
+}
+constexpr MidiAction momentaryCC(uint8_t button, uint8_t channel, uint8_t cc) {
+    return {button, ActionOp::MOMENTARY_CC, channel, cc, 127, 0};
+}
+constexpr MidiAction toggleCC(uint8_t button, uint8_t channel, uint8_t cc) {
+    return {button, ActionOp::TOGGLE_CC, channel, cc, 127, 0};
+}
+constexpr MidiAction sendNote(uint8_t button, uint8_t channel, uint8_t note, uint8_t velocity) {
+    return {button, ActionOp::NOTE, channel, note, velocity, 0};
+}
+constexpr MidiAction aftertouch(uint8_t button, uint8_t channel, uint8_t note) {
+    return {button, ActionOp::AFTERTOUCH, channel, note, 0, 0};
+}
+constexpr MidiAction pressureCC(uint8_t button, uint8_t channel, uint8_t cc) {
+    return {button, ActionOp::PRESSURE_CC, channel, cc, 0, 0};
+}
+
+/// Message produced by the interpreter
+struct MidiMessage {
+    enum class Kind : uint8_t { CC, NOTE_ON, NOTE_OFF, POLY_PRESSURE } kind;
+    uint8_t channel;
+    uint8_t number;
+    uint8_t value;
+};
+
+/**
+ * @brief Runtime copy of a constexpr action table plus its interpreter
+ */
+template <size_t N>
+class ActionTable {
+public:
+    constexpr explicit ActionTable(const std::array<MidiAction, N>& actions) : actions_(actions) {}
+
+    /**
+     * @brief Run every action bound to the event's button
+     * @param sink Callable (const MidiMessage&)
+     */
+    template <typename Sink>
+    void run(const InputEvent& event, Sink&& sink) {
+        if (event.source != InputSource::BUTTON) return;
+        const bool press = event.type == InputType::PRESS;
+        const bool pressure = event.type == InputType::PRESSURE;
+        if (!press && !pressure && event.type != InputType::RELEASE) return;  // Gestures: bind them in code
+        const uint8_t amount = static_cast<uint8_t>(event.delta);
+
+        for (MidiAction& a : actions_) {
+            if (a.button != event.id) continue;
+            const bool pressureOp = a.op == ActionOp::AFTERTOUCH || a.op == ActionOp::PRESSURE_CC;
+            if (pressure != pressureOp) continue;
+            switch (a.op) {
+                case ActionOp::SEND_CC:
+                    if (press) sink(MidiMessage{MidiMessage::Kind::CC, a.channel, a.number, a.value});
+                    break;
+                case ActionOp::MOMENTARY_CC:
+                    sink(MidiMessage{MidiMessage::Kind::CC, a.channel, a.number, press ? a.value : uint8_t(0)});
+                    break;
+                case ActionOp::TOGGLE_CC:
+                    if (!press) break;
+                    a.state = a.state ? 0 : a.value;
+                    sink(MidiMessage{MidiMessage::Kind::CC, a.channel, a.number, a.state});
+                    break;
+                case ActionOp::NOTE:
+                    sink(MidiMessage{press ? MidiMessage::Kind::NOTE_ON : MidiMessage::Kind::NOTE_OFF,
+                                     a.channel, a.number, press ? a.value : uint8_t(0)});
+                    break;
+                case ActionOp::AFTERTOUCH:
+                    sink(MidiMessage{MidiMessage::Kind::POLY_PRESSURE, a.channel, a.number, amount});
+                    break;
+                case ActionOp::PRESSURE_CC:
+                    sink(MidiMessage{MidiMessage::Kind::CC, a.channel, a.number, amount});
+                    break;
+            }
+        }
+    }
+
+    const std::array<MidiAction, N>& actions() const { return actions_; }
+
+private:
+    std::array<MidiAction, N> actions_;
+};
+
+}  // namespace example
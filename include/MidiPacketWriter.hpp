@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * @file MidiPacketWriter.hpp
+ * @brief USB-MIDI event packets written straight to the transmit buffer
+ *
+ * A USB-MIDI event is one 32-bit packet: cable/CIN, status, data1, data2.
+ * High-volume senders (resync bursts, pressure streams) build it in a
+ * register and hand it to the port in one call - no message object, no
+ * intermediate queue - and decide themselves when the buffer goes out:
+ *
+ *   writer.write(packet::cc(0, 20, 127));
+ *   writer.write(packet::cc(0, 21, 0));
+ *   writer.commit();   // one USB transfer for both
+ *
+ * SysEx goes the same way (writeSysEx(), 3 bytes per packet), so replies
+ * share the commit policy of the channel messages.
+ *
+ * The port is a template parameter: UsbMidiPort on the Teensy, any class
+ * with write(uint32_t) / flush() on the host.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef ARDUINO
+#include <usb_midi.h>
+#endif
+
+namespace example {
+
+namespace packet {
+    /// Packet for a 3-byte channel message; CIN = status high nibble
+    constexpr uint32_t channel(uint8_t status, uint8_t data1, uint8_t data2, uint8_t cable = 0) {
+        return uint32_t((cable << 4) | (status >> 4)) | (uint32_t(status) << 8) |
+               (uint32_t(data1 & 0x7F) << 16) | (uint32_t(data2 & 0x7F) << 24);
+    }
+
+    constexpr uint32_t cc(uint8_t ch, uint8_t cc, uint8_t value) {
+        return channel(static_cast<uint8_t>(0xB0 | (ch & 0x0F)), cc, value);
+    }
+    constexpr uint32_t noteOn(uint8_t ch, uint8_t note, uint8_t velocity) {
+        return channel(static_cast<uint8_t>(0x90 | (ch & 0x0F)), note, velocity);
+    }
+    constexpr uint32_t noteOff(uint8_t ch, uint8_t note, uint8_t velocity) {
+        return channel(static_cast<uint8_t>(0x80 | (ch & 0x0F)), note, velocity);
+    }
+    constexpr uint32_t polyPressure(uint8_t ch, uint8_t note, uint8_t pressure) {
+        return channel(static_cast<uint8_t>(0xA0 | (ch & 0x0F)), note, pressure);
+    }
+
+    /// SysEx packet: CIN 0x4 (start/continue, 3 bytes) or 0x5..0x7 (end, 1..3 bytes)
+    constexpr uint32_t sysex(uint8_t cin, uint8_t b0, uint8_t b1 = 0, uint8_t b2 = 0, uint8_t cable = 0) {
+        return uint32_t((cable << 4) | cin) | (uint32_t(b0) << 8) | (uint32_t(b1) << 16) | (uint32_t(b2) << 24);
+    }
+}  // namespace packet
+
+#ifdef ARDUINO
+/// Teensy core: packets go straight into the endpoint transmit buffer
+struct UsbMidiPort {
+    void write(uint32_t packet) { usb_midi_write_packed(packet); }
+    void flush() { usb_midi_flush_output(); }
+};
+#endif
+
+template <typename Port>
+class MidiPacketWriter {
+public:
+    explicit MidiPacketWriter(Port port = Port{}) : port_(port) {}
+
+    void write(uint32_t packet) {
+        port_.write(packet);
+        ++pending_;
+        ++total_;
+    }
+
+    /// A complete SysEx message, F0 to F7 included
+    void writeSysEx(const uint8_t* data, size_t size) {
+        for (; size > 3; data += 3, size -= 3) write(packet::sysex(0x4, data[0], data[1], data[2]));
+        if (size == 3) write(packet::sysex(0x7, data[0], data[1], data[2]));
+        else if (size == 2) write(packet::sysex(0x6, data[0], data[1]));
+        else if (size == 1) write(packet::sysex(0x5, data[0]));
+    }
+
+    /// Send what was written since the last commit (no-op when nothing was)
+    void commit() {
+        if (pending_ == 0) return;
+        port_.flush();
+        pending_ = 0;
+    }
+
+    uint32_t pending() const { return pending_; }
+    uint32_t total() const { return total_; }
+    Port& port() { return port_; }
+
+private:
+    Port port_;
+    uint32_t pending_ = 0;
+    uint32_t total_ = 0;
+};
+
+}  // namespace example
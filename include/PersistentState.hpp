@@ -0,0 +1,225 @@
+#pragma once
+
+/**
+ * @file PersistentState.hpp
+ * @brief Wear-leveled key/value journal for context state, written incrementally
+ *
+ * A context keeps its persistent values in a small RAM mirror (one byte per key)
+ * and calls set() from its handlers - which only touches RAM. The changes are
+ * appended to a ring journal in EEPROM by service(), one byte per call, so no
+ * single update() pays for a whole record.
+ *
+ * Journal layout: SLOTS records of 4 bytes { seq, key, value, check }
+ * - seq grows by one per record (mod 256): the newest record is found by
+ *   looking for the break in the sequence, no header block to wear out
+ * - a record is written key = 0xFF (invalid) first, then seq, value, check,
+ *   and the real key last. Until that last byte lands the slot is invalid,
+ *   whatever the old bytes were; a torn key byte alone is a single-byte error,
+ *   which the CRC-8 always detects
+ * - the slot right after the write head never holds the only copy of a key:
+ *   such a key is re-appended first, so every key survives the ring wrapping
+ *
+ * begin() makes a fixed number of passes over the ring (no replay of the write
+ * history), so boot time is bounded by SLOTS.
+ */
+
+#include <array>
+#include <cstdint>
+
+#ifdef ARDUINO
+#include <EEPROM.h>
+#endif
+
+namespace example {
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Storage backends
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifdef ARDUINO
+/**
+ * @brief Byte storage backed by the Teensy EEPROM emulation
+ *
+ * On Teensy 4 the EEPROM is emulated in flash: a write usually takes a few
+ * microseconds, but when the emulation runs out of room in its sector it
+ * erases one first, and that write blocks for tens of milliseconds.
+ *
+ * Any type with the same read()/write() pair can replace it (e.g. the flash
+ * model with power-loss injection in test/test_persistent_state.cpp).
+ */
+template <uint16_t BASE>
+struct EepromStorage {
+    uint8_t read(uint16_t offset) const { return EEPROM.read(BASE + offset); }
+    void write(uint16_t offset, uint8_t value) { EEPROM.update(BASE + offset, value); }
+};
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PersistentState
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief RAM mirror of KEYS bytes, journaled into SLOTS records of Storage
+ *
+ * @tparam KEYS    Number of persisted values (keys 0..KEYS-1)
+ * @tparam SLOTS   Journal length in records (4 bytes each)
+ * @tparam Storage Byte storage providing read(offset) and write(offset, value)
+ */
+template <uint8_t KEYS, uint16_t SLOTS, typename Storage>
+class PersistentState {
+    static_assert(KEYS > 0, "PersistentState needs at least one key");
+    static_assert(SLOTS >= KEYS + 2, "Journal must hold every key plus the write head");
+    static_assert(KEYS <= 32, "Dirty keys are tracked in a 32-bit mask");
+    static_assert(SLOTS < 256, "Sequence numbers are 8-bit: keep SLOTS below 256");
+
+public:
+    static constexpr uint16_t RECORD_SIZE = 4;
+    static constexpr uint16_t STORAGE_SIZE = SLOTS * RECORD_SIZE;
+    static constexpr uint8_t WRITES_PER_RECORD = 5;  ///< Key invalidated first, written again last
+
+    explicit PersistentState(Storage storage = Storage{}) : storage_(storage) {}
+
+    /**
+     * @brief Rebuild the RAM mirror from the journal
+     *
+     * Keys never written keep their default value (0).
+     */
+    void begin() {
+        values_.fill(0);
+        liveSlot_.fill(NO_SLOT);
+        dirty_ = 0;
+        step_ = 0;
+
+        // The chain cannot cover the whole ring (SLOTS < 256), so there is
+        // always a slot where a run starts: walk from there once to find
+        // the end of the longest run, which is the newest record.
+        uint16_t start = 0;
+        for (uint16_t i = 0; i < SLOTS; ++i) {
+            if (!follows(prev(i), i)) { start = i; break; }
+        }
+
+        uint16_t newest = NO_SLOT;
+        uint16_t bestRun = 0;
+        uint16_t run = 0;
+        for (uint16_t n = 0; n < SLOTS; ++n) {
+            uint16_t i = (start + n) % SLOTS;
+            if (!valid(i)) { run = 0; continue; }
+            run = follows(prev(i), i) ? run + 1 : 1;
+            if (run > bestRun) { bestRun = run; newest = i; }
+        }
+
+        if (newest == NO_SLOT) {
+            head_ = 0;
+            seq_ = 0;
+            return;
+        }
+
+        // Replay the newest run, oldest record first
+        for (uint16_t n = bestRun; n > 0; --n) {
+            uint16_t i = (newest + SLOTS - (n - 1)) % SLOTS;
+            uint8_t key = readByte(i, KEY);
+            values_[key] = readByte(i, VALUE);
+            liveSlot_[key] = i;
+        }
+        head_ = (newest + 1) % SLOTS;
+        seq_ = static_cast<uint8_t>(readByte(newest, SEQ) + 1);
+    }
+
+    uint8_t get(uint8_t key) const { return values_[key]; }
+
+    /// Update the RAM mirror; the journal catches up in service()
+    void set(uint8_t key, uint8_t value) {
+        if (values_[key] == value) return;
+        values_[key] = value;
+        dirty_ |= 1u << key;
+    }
+
+    /// True while changes are waiting to reach storage
+    bool pending() const { return dirty_ != 0 || step_ != 0; }
+
+    /**
+     * @brief Write at most one journal byte
+     *
+     * Call once per tick. A record takes WRITES_PER_RECORD calls to land.
+     */
+    void service() {
+        if (step_ == 0) {
+            if (dirty_ == 0) return;
+            stageRecord();
+        }
+        const Field field = WRITE_ORDER[step_];
+        const uint8_t byte = step_ == 0 ? INVALID_KEY : record_[field];
+        storage_.write(head_ * RECORD_SIZE + field, byte);
+        if (++step_ < WRITES_PER_RECORD) return;
+
+        step_ = 0;
+        liveSlot_[record_[KEY]] = head_;
+        head_ = (head_ + 1) % SLOTS;
+        ++seq_;
+    }
+
+private:
+    static constexpr uint16_t NO_SLOT = 0xFFFF;
+    static constexpr uint8_t INVALID_KEY = 0xFF;
+    enum Field : uint8_t { SEQ = 0, KEY = 1, VALUE = 2, CHECK = 3 };
+    static constexpr Field WRITE_ORDER[WRITES_PER_RECORD] = {KEY, SEQ, VALUE, CHECK, KEY};
+
+    static uint8_t checksum(uint8_t seq, uint8_t key, uint8_t value) {
+        // CRC-8 (poly 0x07) seeded so that erased storage (all 0xFF) never passes
+        uint8_t crc = 0x5A;
+        for (uint8_t byte : {seq, key, value}) {
+            crc ^= byte;
+            for (uint8_t bit = 0; bit < 8; ++bit) {
+                crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07)
+                                   : static_cast<uint8_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    /// Pick what goes into the head slot: rescue the key living in the next
+    /// slot first, otherwise the next dirty key
+    void stageRecord() {
+        uint16_t next = (head_ + 1) % SLOTS;
+        uint8_t key = KEYS;
+        for (uint8_t k = 0; k < KEYS; ++k) {
+            if (liveSlot_[k] == next) { key = k; break; }
+        }
+        if (key == KEYS) {
+            for (uint8_t k = 0; k < KEYS; ++k) {
+                if (dirty_ & (1u << k)) { key = k; break; }
+            }
+        }
+        dirty_ &= ~(1u << key);
+
+        record_ = {seq_, key, values_[key], checksum(seq_, key, values_[key])};
+    }
+
+    uint8_t readByte(uint16_t slot, Field field) const {
+        return storage_.read(slot * RECORD_SIZE + field);
+    }
+
+    bool valid(uint16_t slot) const {
+        uint8_t key = readByte(slot, KEY);
+        return key < KEYS
+            && readByte(slot, CHECK) == checksum(readByte(slot, SEQ), key, readByte(slot, VALUE));
+    }
+
+    bool follows(uint16_t before, uint16_t slot) const {
+        return valid(before) && valid(slot)
+            && static_cast<uint8_t>(readByte(before, SEQ) + 1) == readByte(slot, SEQ);
+    }
+
+    static uint16_t prev(uint16_t slot) { return (slot + SLOTS - 1) % SLOTS; }
+
+    Storage storage_;
+    std::array<uint8_t, KEYS> values_{};
+    std::array<uint16_t, KEYS> liveSlot_{};
+    std::array<uint8_t, RECORD_SIZE> record_{};
+    uint32_t dirty_ = 0;
+    uint16_t head_ = 0;
+    uint8_t seq_ = 0;
+    uint8_t step_ = 0;
+};
+
+}  // namespace example
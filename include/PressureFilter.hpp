@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file PressureFilter.hpp
+ * @brief Press/release and rate-limited pressure from raw FSR readings
+ *
+ * One filter per pad, fed with raw ADC counts (larger = harder):
+ * - smoothing: moving average (1/2^smoothShift per sample, x16 fixed point)
+ * - press/release: smoothed value crosses pressOn / falls under pressOff
+ * - pressure: 0..127 over pressOff..full, emitted only when it moved by at
+ *   least minChange AND minIntervalUs passed since the last emission
+ *
+ * Release always emits a final 0 so the receiver never keeps a stale
+ * pressure. No hardware: runs as is on the host against recorded curves.
+ */
+
+#include <cstdint>
+
+namespace example {
+
+class PressureFilter {
+public:
+    struct Tuning {
+        uint16_t pressOn = 120;          ///< Counts to register a press
+        uint16_t pressOff = 80;          ///< Counts to register a release (< pressOn)
+        uint16_t full = 900;             ///< Counts mapped to pressure 127
+        uint8_t smoothShift = 2;         ///< Smoothing: 1/4 per sample
+        uint8_t minChange = 2;           ///< Pressure dead band
+        uint32_t minIntervalUs = 5000;   ///< At most 200 pressure updates/s per pad
+    };
+
+    struct Output {
+        bool edge = false;          ///< pressed changed on this sample
+        bool pressed = false;
+        bool hasPressure = false;   ///< pressure must be sent
+        uint8_t pressure = 0;
+    };
+
+    PressureFilter() = default;
+    explicit PressureFilter(Tuning tuning) : tuning_(tuning) {}
+
+    Output update(uint16_t raw, uint32_t nowUs) {
+        const int32_t value = int32_t(raw) << 4;
+        smoothed_ = primed_ ? smoothed_ + ((value - smoothed_) >> tuning_.smoothShift) : value;
+        primed_ = true;
+        const uint16_t level = static_cast<uint16_t>(smoothed_ >> 4);
+
+        Output out;
+        if (!pressed_ && level >= tuning_.pressOn) {
+            pressed_ = true;
+            out.edge = true;
+        } else if (pressed_ && level < tuning_.pressOff) {
+            pressed_ = false;
+            out.edge = true;
+        }
+        out.pressed = pressed_;
+
+        if (!pressed_) {
+            if (out.edge && sent_ != 0) emit(out, 0, nowUs);
+            return out;
+        }
+
+        const uint8_t p = scale(level);
+        const int32_t moved = int32_t(p) - int32_t(sent_);
+        const bool due = out.edge || nowUs - sentUs_ >= tuning_.minIntervalUs;
+        if (due && (moved >= tuning_.minChange || -moved >= tuning_.minChange)) emit(out, p, nowUs);
+        return out;
+    }
+
+    bool pressed() const { return pressed_; }
+    uint8_t lastSent() const { return sent_; }
+
+private:
+    uint8_t scale(uint16_t level) const {
+        if (level <= tuning_.pressOff) return 0;
+        if (level >= tuning_.full) return 127;
+        return static_cast<uint8_t>(uint32_t(level - tuning_.pressOff) * 127 / (tuning_.full - tuning_.pressOff));
+    }
+
+    void emit(Output& out, uint8_t pressure, uint32_t nowUs) {
+        out.hasPressure = true;
+        out.pressure = pressure;
+        sent_ = pressure;
+        sentUs_ = nowUs;
+    }
+
+    Tuning tuning_{};
+    int32_t smoothed_ = 0;
+    uint32_t sentUs_ = 0;
+    uint8_t sent_ = 0;
+    bool primed_ = false;
+    bool pressed_ = false;
+};
+
+}  // namespace example
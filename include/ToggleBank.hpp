@@ -0,0 +1,125 @@
+#pragma once
+
+/**
+ * @file ToggleBank.hpp
+ * @brief Toggle and radio-group button behaviors stored in packed bitmaps
+ *
+ * Each toggle is one bit: 64 toggles take 8 bytes instead of 64 bools
+ * scattered across contexts, and the whole state can be copied out for a
+ * snapshot or persistence as plain bytes.
+ *
+ * Radio groups are precomputed bit masks: selecting slot s of a group is
+ *
+ *   word = (word & ~groupMask) | bit(s)
+ *
+ * with no per-member branches. Changes are reported as the XOR of the
+ * words before and after, one callback per flipped bit.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "InputPipeline.hpp"
+
+namespace example {
+
+/**
+ * @tparam SLOTS        Number of toggle bits
+ * @tparam MAX_BINDINGS Button-to-slot bindings
+ * @tparam MAX_GROUPS   Radio groups
+ */
+template <size_t SLOTS, size_t MAX_BINDINGS = 16, size_t MAX_GROUPS = 4>
+class ToggleBank {
+public:
+    static constexpr size_t WORDS = (SLOTS + 31) / 32;
+    static constexpr size_t BYTES = (SLOTS + 7) / 8;
+    static constexpr uint8_t NO_GROUP = 0xFF;
+
+    /// Button press flips slot
+    bool bindToggle(uint8_t button, uint16_t slot) { return bind(button, slot, NO_GROUP); }
+
+    /// Button press selects slot, clearing the rest of the group
+    bool bindRadio(uint8_t button, uint16_t slot, uint8_t group) {
+        if (group >= MAX_GROUPS || slot >= SLOTS) return false;
+        groupMasks_[group][slot / 32] |= bitOf(slot);
+        return bind(button, slot, group);
+    }
+
+    bool get(uint16_t slot) const { return (words_[slot / 32] & bitOf(slot)) != 0; }
+
+    /**
+     * @brief Apply button events bound to this bank
+     * @param onChange Callable (uint16_t slot, bool on), once per flipped bit
+     */
+    template <typename OnChange>
+    void handle(const InputEvent& event, OnChange&& onChange) {
+        if (event.source != InputSource::BUTTON || event.type != InputType::PRESS) return;
+        for (size_t i = 0; i < count_; ++i) {
+            if (buttons_[i] != event.id) continue;
+            const uint16_t slot = slots_[i];
+            set(slot, groups_[i] == NO_GROUP ? !get(slot) : true, onChange);
+        }
+    }
+
+    /// Set a slot (radio slots clear their group when set), reporting changes
+    template <typename OnChange>
+    void set(uint16_t slot, bool on, OnChange&& onChange) {
+        const std::array<uint32_t, WORDS> before = words_;
+        const uint8_t group = groupOf(slot);
+        if (on && group != NO_GROUP) {
+            for (size_t w = 0; w < WORDS; ++w) words_[w] &= ~groupMasks_[group][w];
+        }
+        if (on) words_[slot / 32] |= bitOf(slot);
+        else words_[slot / 32] &= ~bitOf(slot);
+
+        for (size_t w = 0; w < WORDS; ++w) {
+            for (uint32_t diff = before[w] ^ words_[w]; diff; diff &= diff - 1) {
+                const uint16_t s = static_cast<uint16_t>(w * 32 + __builtin_ctz(diff));
+                onChange(s, get(s));
+            }
+        }
+    }
+
+    // ───────────────────────────────────────────────────────────────────────
+    // Raw state for snapshot / persistence
+    // ───────────────────────────────────────────────────────────────────────
+
+    uint8_t byte(size_t index) const {
+        return static_cast<uint8_t>(words_[index / 4] >> ((index % 4) * 8));
+    }
+
+    /// Restore raw state (no change callbacks)
+    void setByte(size_t index, uint8_t value) {
+        const uint32_t shift = (index % 4) * 8;
+        words_[index / 4] = (words_[index / 4] & ~(0xFFu << shift)) | (uint32_t(value) << shift);
+    }
+
+private:
+    static constexpr uint32_t bitOf(uint16_t slot) { return 1u << (slot % 32); }
+
+    bool bind(uint8_t button, uint16_t slot, uint8_t group) {
+        if (count_ >= MAX_BINDINGS || slot >= SLOTS) return false;
+        buttons_[count_] = button;
+        slots_[count_] = slot;
+        groups_[count_] = group;
+        ++count_;
+        return true;
+    }
+
+    uint8_t groupOf(uint16_t slot) const {
+        for (size_t g = 0; g < MAX_GROUPS; ++g) {
+            if (groupMasks_[g][slot / 32] & bitOf(slot)) return static_cast<uint8_t>(g);
+        }
+        return NO_GROUP;
+    }
+
+    std::array<uint32_t, WORDS> words_{};
+    std::array<std::array<uint32_t, WORDS>, MAX_GROUPS> groupMasks_{};
+    std::array<uint8_t, MAX_BINDINGS> buttons_{};
+    std::array<uint16_t, MAX_BINDINGS> slots_{};
+    std::array<uint8_t, MAX_BINDINGS> groups_{};
+    size_t count_ = 0;
+};
+
+}  // namespace example
@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+ * @file TouchButtonSource.hpp
+ * @brief Capacitive touch pads measured round-robin, feeding the InputPipeline
+ *
+ * Teensy 4 has no touch-sensing peripheral, so each pad is measured by its
+ * RC charge time: the pad is discharged, released to the internal pull-up,
+ * and the cycle counter times how long it takes to read high. A finger adds
+ * capacitance and lengthens that time.
+ *
+ * poll() measures ONE pad per call, bounded by timeoutCycles, so the
+ * worst-case cost of an update() is one capped measurement whatever the
+ * number of pads. Interrupts are masked while the charge time is measured
+ * (at most timeoutCycles, 20 us by default): an ISR landing in the timed
+ * loop would read as a touch. They are served right after.
+ *
+ * TouchDetector turns readings into touch decisions; edges go through the
+ * shared Debouncer into the pipeline.
+ */
+
+#include <Arduino.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Debouncer.hpp"
+#include "TouchDetector.hpp"
+#include "Trace.hpp"
+
+namespace example {
+
+struct TouchPad {
+    uint8_t id;
+    uint8_t pin;
+};
+
+template <size_t N>
+class TouchButtonSource : public Traced {
+public:
+    /**
+     * @param timeoutCycles Measurement cap (CPU cycles); a reading at the cap
+     *                      is still valid, just saturated
+     */
+    TouchButtonSource(const std::array<TouchPad, N>& pads, uint32_t timeoutCycles, uint32_t debounceUs)
+        : pads_(pads), timeoutCycles_(timeoutCycles), debouncer_(debounceUs) {}
+
+    void begin() {
+        for (size_t i = 0; i < N; ++i) {
+            psr_[i] = portInputRegister(pads_[i].pin);
+            mask_[i] = digitalPinToBitMask(pads_[i].pin);
+            pinMode(pads_[i].pin, OUTPUT);
+            digitalWriteFast(pads_[i].pin, LOW);
+        }
+    }
+
+    template <typename Pipeline>
+    void poll(Pipeline& pipeline, uint32_t nowUs) {
+        const size_t i = next_;
+        next_ = (next_ + 1) % N;
+
+        const uint16_t reading = measure(i);
+        lastReading_[i] = reading;
+        if (detectors_[i].update(reading, nowUs)) touched_ |= 1u << i;
+        else touched_ &= ~(1u << i);
+
+        const uint32_t changed = debouncer_.update(touched_, nowUs);
+        for (uint32_t bits = changed; bits; bits &= bits - 1) {
+            const uint32_t b = __builtin_ctz(bits);
+            const bool pressed = (debouncer_.state() >> b) & 1u;
+            EX_TRACE_INSTANT(tracer_, "touch", pads_[b].id, pressed);
+            pipeline.pushButton(pads_[b].id, pressed, nowUs);
+        }
+    }
+
+    uint16_t lastReading(size_t pad) const { return lastReading_[pad]; }
+    const TouchDetector& detector(size_t pad) const { return detectors_[pad]; }
+
+private:
+    /// Charge time of one pad in CPU cycles, capped at timeoutCycles_
+    uint16_t measure(size_t i) {
+        const uint8_t pin = pads_[i].pin;
+        volatile uint32_t* psr = psr_[i];
+        const uint32_t mask = mask_[i];
+
+        uint32_t primask;
+        __asm__ volatile("mrs %0, primask" : "=r"(primask));
+        __disable_irq();
+        pinMode(pin, INPUT_PULLUP);
+        const uint32_t start = ARM_DWT_CYCCNT;
+        uint32_t elapsed = 0;
+        while (!(*psr & mask) && (elapsed = ARM_DWT_CYCCNT - start) < timeoutCycles_) {}
+        if (!(primask & 1)) __enable_irq();
+
+        // Discharge right away so the pad is ready for its next turn
+        pinMode(pin, OUTPUT);
+        digitalWriteFast(pin, LOW);
+        return static_cast<uint16_t>(elapsed > 0xFFFF ? 0xFFFF : elapsed);
+    }
+
+    std::array<TouchPad, N> pads_;
+    std::array<volatile uint32_t*, N> psr_{};
+    std::array<uint32_t, N> mask_{};
+    std::array<TouchDetector, N> detectors_{};
+    std::array<uint16_t, N> lastReading_{};
+    uint32_t timeoutCycles_;
+    uint32_t touched_ = 0;
+    size_t next_ = 0;
+    Debouncer<N> debouncer_;
+};
+
+}  // namespace example
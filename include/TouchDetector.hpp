@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * @file TouchDetector.hpp
+ * @brief Touch decision from raw capacitance readings, with drift tracking
+ *
+ * Readings are charge times (larger = more capacitance = finger). Per pad:
+ * - baseline: slow moving average while untouched, so temperature/humidity
+ *   drift is followed. It holds while touched, so a long touch is not
+ *   absorbed - but a touch lasting longer than maxTouchUs (the untouched
+ *   level rose during a touch, water on the pad) is taken as the new
+ *   baseline and released instead of sticking
+ * - noise: moving average of |reading - baseline| while untouched
+ * - thresholds adapt to the noise: touch at baseline + max(minDelta, k x noise),
+ *   release at half that delta (hysteresis)
+ *
+ * Integer fixed point (baseline and noise scaled by 16), no hardware: the same
+ * code runs on the host against recorded or synthetic traces.
+ */
+
+#include <cstdint>
+
+namespace example {
+
+class TouchDetector {
+public:
+    struct Tuning {
+        uint16_t minDelta = 300;    ///< Smallest touch delta, in reading units (0.5 us of charge time)
+        uint8_t noiseFactor = 4;    ///< Touch delta = noiseFactor x noise when larger
+        uint8_t baselineShift = 6;  ///< Baseline filter: 1/64 per sample
+        uint8_t noiseShift = 4;     ///< Noise filter: 1/16 per sample
+        uint32_t maxTouchUs = 30000000;  ///< Longer touches recalibrate the baseline (30 s)
+    };
+
+    TouchDetector() = default;
+    explicit TouchDetector(Tuning tuning) : tuning_(tuning) {}
+
+    /// Feed one reading taken at nowUs; returns the touch state
+    bool update(uint16_t reading, uint32_t nowUs) {
+        const int32_t value = int32_t(reading) << 4;
+        if (!primed_) {
+            baseline_ = value;
+            primed_ = true;
+            return false;
+        }
+
+        const int32_t delta = (value - baseline_) >> 4;
+        const int32_t touchDelta = threshold();
+        if (touched_) {
+            if (delta < touchDelta / 2) {
+                touched_ = false;
+            } else if (nowUs - touchedAtUs_ > tuning_.maxTouchUs) {
+                baseline_ = value;  // Stuck: this level is the new untouched one
+                touched_ = false;
+                return false;
+            }
+        } else if (delta > touchDelta) {
+            touched_ = true;
+            touchedAtUs_ = nowUs;
+        }
+
+        if (!touched_) {
+            const int32_t deviation = (delta < 0 ? -delta : delta) << 4;
+            baseline_ += (value - baseline_) >> tuning_.baselineShift;
+            noise_ += (deviation - noise_) >> tuning_.noiseShift;
+        }
+        return touched_;
+    }
+
+    bool touched() const { return touched_; }
+    uint16_t baseline() const { return static_cast<uint16_t>(baseline_ >> 4); }
+
+    /// Current touch delta above baseline, in reading units
+    int32_t threshold() const {
+        const int32_t adaptive = (noise_ * tuning_.noiseFactor) >> 4;
+        return adaptive > tuning_.minDelta ? adaptive : tuning_.minDelta;
+    }
+
+private:
+    Tuning tuning_{};
+    int32_t baseline_ = 0;
+    int32_t noise_ = 0;
+    uint32_t touchedAtUs_ = 0;
+    bool primed_ = false;
+    bool touched_ = false;
+};
+
+}  // namespace example
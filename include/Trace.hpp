@@ -0,0 +1,186 @@
+#pragma once
+
+/**
+ * @file Trace.hpp
+ * @brief Span/instant event tracing with Chrome trace JSON export
+ *
+ * Records 12-byte events (cycle timestamp, static name, phase, small args)
+ * into a RAM ring buffer. writeChromeJson() streams the ring as Chrome trace
+ * JSON, which chrome://tracing and ui.perfetto.dev both open directly.
+ *
+ * Compile-time removable, like OC_LOG:
+ * - build with -D EX_TRACE to record
+ * - without it every EX_TRACE_* macro expands to nothing
+ *
+ * There is no process-wide buffer: the owner creates a Tracer and hands a
+ * pointer to each component (setTracer()); a null sink records nothing.
+ *
+ *   EX_TRACE_SCOPE(tracer_, "dispatch");            // span until end of scope
+ *   EX_TRACE_INSTANT(tracer_, "sendCC", cc, value); // single point
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+namespace example {
+
+struct TraceEvent {
+    uint32_t cycles;
+    const char* name;  ///< Must be a string literal (stored by pointer)
+    char phase;        ///< 'B' begin, 'E' end, 'i' instant (Chrome phases)
+    uint8_t arg0;
+    uint16_t arg1;
+};
+
+/**
+ * @brief Ring of the most recent CAPACITY events
+ */
+template <size_t CAPACITY>
+class TraceBuffer {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+public:
+    static uint32_t now() {
+#ifdef ARDUINO
+        return ARM_DWT_CYCCNT;
+#else
+        using namespace std::chrono;
+        return static_cast<uint32_t>(
+            duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /// Timestamp ticks per microsecond
+    static double ticksPerUs() {
+#ifdef ARDUINO
+        return F_CPU_ACTUAL / 1e6;
+#else
+        return 1000.0;
+#endif
+    }
+
+    void record(const char* name, char phase, uint8_t arg0 = 0, uint16_t arg1 = 0) {
+        recordAt(now(), name, phase, arg0, arg1);
+    }
+
+    /// Same, stamped by the caller (replayed or simulated timelines)
+    void recordAt(uint32_t cycles, const char* name, char phase, uint8_t arg0 = 0, uint16_t arg1 = 0) {
+        events_[head_ & MASK] = {cycles, name, phase, arg0, arg1};
+        ++head_;
+    }
+
+    void clear() { head_ = 0; }
+    size_t size() const { return head_ < CAPACITY ? head_ : CAPACITY; }
+
+    /**
+     * @brief Measure the cost of one record() in timestamp ticks
+     *
+     * Clears the buffer: call once at startup.
+     */
+    uint32_t calibrate() {
+        constexpr uint32_t RUNS = 64;
+        uint32_t start = now();
+        for (uint32_t i = 0; i < RUNS; ++i) record("calibrate", 'i');
+        uint32_t ticks = (now() - start) / RUNS;
+        clear();
+        overheadTicks_ = ticks;
+        return ticks;
+    }
+
+    uint32_t overheadTicks() const { return overheadTicks_; }
+
+    /**
+     * @brief Stream the ring as Chrome trace JSON, oldest event first
+     *
+     * @param out Any object with write(const char*, size_t) (Arduino Print, file wrapper...)
+     *
+     * The cycle counter wraps (~7 s at 600 MHz): timestamps are unwrapped
+     * assuming consecutive events are less than one wrap apart.
+     */
+    template <typename Out>
+    void writeChromeJson(Out& out) const {
+        char line[128];
+        auto emit = [&](int n) { if (n > 0) out.write(line, static_cast<size_t>(n)); };
+
+        emit(snprintf(line, sizeof(line), "{\"traceEvents\":[\n"));
+        const size_t count = size();
+        const size_t first = head_ - count;
+        const double perUs = ticksPerUs();
+        uint64_t elapsed = 0;
+        uint32_t previous = count ? events_[first & MASK].cycles : 0;
+
+        for (size_t n = 0; n < count; ++n) {
+            const TraceEvent& e = events_[(first + n) & MASK];
+            elapsed += static_cast<uint32_t>(e.cycles - previous);
+            previous = e.cycles;
+            emit(snprintf(line, sizeof(line),
+                          "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":1%s"
+                          ",\"args\":{\"a\":%u,\"b\":%u}}\n",
+                          n ? "," : "", e.name, e.phase, elapsed / perUs,
+                          e.phase == 'i' ? ",\"s\":\"t\"" : "",
+                          static_cast<unsigned>(e.arg0), static_cast<unsigned>(e.arg1)));
+        }
+        emit(snprintf(line, sizeof(line), "]}\n"));
+    }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+
+    TraceEvent events_[CAPACITY]{};
+    size_t head_ = 0;
+    uint32_t overheadTicks_ = 0;
+};
+
+/// Begin/end span bound to a scope (no-op on a null buffer)
+template <typename Buffer>
+class TraceScope {
+public:
+    TraceScope(Buffer* buffer, const char* name) : buffer_(buffer), name_(name) {
+        if (buffer_) buffer_->record(name_, 'B');
+    }
+    ~TraceScope() {
+        if (buffer_) buffer_->record(name_, 'E');
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    Buffer* buffer_;
+    const char* name_;
+};
+
+#ifndef EX_TRACE_CAPACITY
+#define EX_TRACE_CAPACITY 1024
+#endif
+
+using Tracer = TraceBuffer<EX_TRACE_CAPACITY>;
+
+/// Base for components that emit trace events into an injected sink
+class Traced {
+public:
+    void setTracer(Tracer* tracer) { tracer_ = tracer; }
+
+protected:
+    Tracer* tracer_ = nullptr;
+};
+
+}  // namespace example
+
+#ifdef EX_TRACE
+#define EX_TRACE_CONCAT_(a, b) a##b
+#define EX_TRACE_CONCAT(a, b) EX_TRACE_CONCAT_(a, b)
+#define EX_TRACE_SCOPE(sink, name) \
+    example::TraceScope<example::Tracer> EX_TRACE_CONCAT(traceScope_, __LINE__)(sink, name)
+#define EX_TRACE_INSTANT(sink, name, ...) \
+    do { if (sink) (sink)->record(name, 'i', ##__VA_ARGS__); } while (0)
+#else
+#define EX_TRACE_SCOPE(sink, name) ((void)0)
+#define EX_TRACE_INSTANT(sink, name, ...) ((void)0)
+#endif
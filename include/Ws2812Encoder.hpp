@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file Ws2812Encoder.hpp
+ * @brief Incremental WS2812 bitstream encoding for a UART transmitter
+ *
+ * A UART in 7N1 mode with an inverted TX line sends 9 slots per character:
+ * start (high), 7 data bits, stop (low). Grouped by 3, these are exactly
+ * three WS2812 bits of the form [high, bit, low]:
+ *
+ *   slot:  start d0  d1 | d2 d3  d4 | d5 d6  stop
+ *   line:  H     b0  L  | H  b1  L  | H  b2  L
+ *
+ * At 2.4 Mbaud a slot is 417 ns: a 1 is high for 833 ns, a 0 for 417 ns.
+ * A pixel (24 bits, GRB order) is 8 characters.
+ *
+ * set() only stores the color. encode() re-encodes the pixels changed since
+ * the last call and returns how many bytes to send: the stream stops after
+ * the last changed pixel, since the pixels beyond it keep their latched
+ * color. No hardware: the stream can be decoded and checked on the host.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace example {
+
+template <size_t N>
+class Ws2812Encoder {
+public:
+    static constexpr size_t BYTES_PER_PIXEL = 8;
+    static constexpr size_t BYTES = N * BYTES_PER_PIXEL;
+
+    /// @param stream Transmit buffer (DMA source), BYTES long
+    explicit Ws2812Encoder(uint8_t (&stream)[BYTES]) : stream_(stream) {}
+
+    /// RAM only; color is 0xRRGGBB
+    void set(size_t pixel, uint32_t rgb) {
+        if (pixel >= N || colors_[pixel] == rgb) return;
+        colors_[pixel] = rgb;
+        if (pixel < lo_) lo_ = pixel;
+        if (pixel + 1 > hi_) hi_ = pixel + 1;
+    }
+
+    uint32_t get(size_t pixel) const { return colors_[pixel]; }
+    bool dirty() const { return hi_ > 0; }
+
+    /// Full refresh on the next encode() (e.g. at boot)
+    void invalidate() {
+        lo_ = 0;
+        hi_ = N;
+    }
+
+    /**
+     * @brief Encode the changed pixels
+     * @return Bytes of stream to transmit (0 when nothing changed)
+     */
+    size_t encode() {
+        if (!dirty()) return 0;
+        for (size_t p = lo_; p < hi_; ++p) encodePixel(p);
+        const size_t bytes = hi_ * BYTES_PER_PIXEL;
+        lo_ = N;
+        hi_ = 0;
+        return bytes;
+    }
+
+    /// One character for 3 bits, b0 first (data bits are the inverted line levels)
+    static constexpr uint8_t encodeBits(bool b0, bool b1, bool b2) {
+        return static_cast<uint8_t>(0x12 | (b0 ? 0 : 0x01) | (b1 ? 0 : 0x08) | (b2 ? 0 : 0x40));
+    }
+
+private:
+    void encodePixel(size_t p) {
+        const uint32_t rgb = colors_[p];
+        const uint32_t grb = ((rgb & 0x00FF00) << 8) | ((rgb & 0xFF0000) >> 8) | (rgb & 0x0000FF);
+        uint8_t* out = &stream_[p * BYTES_PER_PIXEL];
+        // 24 bits, MSB first; the 8th character carries 3 bits like the others
+        for (int bit = 23; bit >= 0; bit -= 3) {
+            *out++ = encodeBits((grb >> bit) & 1u, (grb >> (bit - 1)) & 1u, (grb >> (bit - 2)) & 1u);
+        }
+    }
+
+    uint8_t (&stream_)[BYTES];
+    std::array<uint32_t, N> colors_{};
+    size_t lo_ = 0;
+    size_t hi_ = N;  // Stream content is undefined until the first encode()
+};
+
+}  // namespace example
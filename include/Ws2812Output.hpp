@@ -0,0 +1,82 @@
+#pragma once
+
+/**
+ * @file Ws2812Output.hpp
+ * @brief WS2812 pixels on Serial1 TX (pin 1), streamed by DMA
+ *
+ * Bit-banged WS2812 drivers disable interrupts for the whole frame. Here
+ * the bitstream (Ws2812Encoder) is sent by DMA into LPUART6, so a frame
+ * costs the CPU only the re-encoding of the changed pixels.
+ *
+ * service() never waits: while the previous frame is still on the wire,
+ * or during the latch gap after it, it returns immediately and the
+ * changes are picked up by a later tick.
+ *
+ * Serial1 is dedicated to the pixels once begin() has run. Pin 1 is also
+ * the default SPI1 MISO: move it (SPI1.setMISO(39)) before SPI1.begin().
+ */
+
+#include <Arduino.h>
+#include <DMAChannel.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Trace.hpp"
+#include "Ws2812Encoder.hpp"
+
+namespace example {
+
+template <size_t N>
+class Ws2812Output : public Traced {
+public:
+    static constexpr size_t BYTES = Ws2812Encoder<N>::BYTES;
+    static constexpr uint32_t BAUD = 2400000;
+    static constexpr uint32_t LATCH_US = 300;  ///< Low time that latches a frame (WS2812B-V5: 280 us)
+
+    /// @param stream DMA source buffer (a plain global lands in DTCM)
+    explicit Ws2812Output(uint8_t (&stream)[BYTES]) : stream_(stream), encoder_(stream) {}
+
+    void begin() {
+        Serial1.begin(BAUD, SERIAL_7N1_TXINV);
+        dma_.begin();
+        dma_.destination(*reinterpret_cast<volatile uint8_t*>(&LPUART6_DATA));
+        dma_.triggerAtHardwareEvent(DMAMUX_SOURCE_LPUART6_TX);
+        dma_.disableOnCompletion();
+        LPUART6_BAUD |= LPUART_BAUD_TDMAE;
+        encoder_.invalidate();
+    }
+
+    /// RAM only; color is 0xRRGGBB
+    void set(size_t pixel, uint32_t rgb) { encoder_.set(pixel, rgb); }
+    uint32_t get(size_t pixel) const { return encoder_.get(pixel); }
+
+    /// Start a frame if pixels changed and the line is free; never blocks
+    bool service(uint32_t nowUs) {
+        if (nowUs - startUs_ < holdUs_ || !encoder_.dirty()) return false;
+        EX_TRACE_SCOPE(tracer_, "pixels");
+
+        const size_t bytes = encoder_.encode();
+        arm_dcache_flush(stream_, bytes);
+        dma_.sourceBuffer(stream_, bytes);
+        dma_.enable();
+
+        // 9 slots of 1/2.4 us per character, then the latch gap
+        startUs_ = nowUs;
+        holdUs_ = static_cast<uint32_t>(bytes * 15 / 4) + LATCH_US + 1;
+        ++frames_;
+        return true;
+    }
+
+    uint32_t frames() const { return frames_; }
+
+private:
+    uint8_t (&stream_)[BYTES];
+    Ws2812Encoder<N> encoder_;
+    DMAChannel dma_{false};
+    uint32_t startUs_ = 0;
+    uint32_t holdUs_ = 0;
+    uint32_t frames_ = 0;
+};
+
+}  // namespace example
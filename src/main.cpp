@@ -2,36 +2,112 @@
  * @file main.cpp
  * @brief Example 03: Buttons - Input Bindings with Fluent API
  *
- * This example introduces the OpenControlApp and the fluent InputBinding API.
- * You'll learn how to bind button events to actions using a clean, readable syntax.
+ * This example introduces the OpenControlApp and a context that reads its own
+ * inputs: buttons and encoder feed one InputPipeline, whose fluent bindings
+ * turn their events into actions with a clean, readable syntax.
  *
  * What you'll learn:
  * - OpenControlApp: the main application orchestrator
  * - IContext: application modes with lifecycle (initialize/update/cleanup)
- * - Fluent InputBinding API: onButton().press().then(...)
+ * - Fluent pipeline bindings: input_.onButton(2).press().then(...)
  * - Button events: press, release, longPress, doubleTap
  * - Using OC_LOG_* for debug output
+ * - Persisting context state across power cycles without stalling the loop
+ * - Resending the full controller state to the DAW without hurting latency
+ * - Showing button state on an ILI9341 screen without blocking input
+ * - One timestamped event stream for buttons and encoders
+ * - Modifier gestures: hold a button while turning the encoder
+ * - Production metrics readable over SysEx, no logging required
+ * - Catching loop stalls: jitter histogram, overrun culprit, hardware watchdog
+ * - Scanning buttons with one GPIO port read per scan
+ * - Declarative MIDI actions: common bindings as data instead of lambdas
+ * - Toggles and radio groups as packed bitmaps instead of per-context bools
+ * - Parameter model: handlers set values, changes go out once per tick
+ * - 8 resistor-ladder buttons on one analog pin, sampled by DMA
+ * - Capacitive touch pads with drift-tracking baselines, one pad per tick
+ * - Force-sensitive pads: press/release plus rate-limited aftertouch
+ * - Button LEDs: handlers write RAM, one batched shift-register flush per tick
+ * - WS2812 pad pixels sent by DMA, only up to the last changed pixel
+ * - Raw USB-MIDI packets: every message of a tick leaves in one transfer
+ * - MIDI output committed once per USB microframe, queueing delay in metrics
+ * - Field latency test: the device times SysEx round trips through the host
+ * - CPU budgets per context: load %, over-budget ticks, deferred feedback
+ * - Background contexts: LED refresh and animation at their own tick rate
  *
  * New concepts:
  * - Context: A mode of operation (standalone, DAW mode, config mode, etc.)
- * - AppBuilder: Fluent configuration of hardware drivers
- * - Requirements: Declare what APIs a context needs
+ * - AppBuilder: Fluent configuration of the framework drivers (MIDI here)
+ * - Requirements: Declare what APIs a context needs (MIDI only: the
+ *   context scans its own buttons and encoder)
+ * - InputPipeline: the context's event queue, binding table and gestures
  *
  * Hardware required:
  * - Teensy 4.1
  * - 2 buttons (normally open, pull-up)
+ * - 1 rotary encoder with push switch
+ *
+ * Optional hardware, each behind its own build flag:
+ * - ILI9341 320x240 SPI display (optional: -D EX_DISPLAY)
+ * - 8 buttons on a resistor ladder (optional: -D EX_LADDER, one analog pin)
+ * - 2 touch pads (optional: -D EX_TOUCH, bare copper or foil, one digital pin each)
+ * - 2 FSR pads (optional: -D EX_FSR, FSR to 3.3V, 10k to GND, on ADC2-capable analog pins)
+ * - 74HC595 driving 8 LEDs on SPI1 (optional: -D EX_LEDS)
+ * - 8 WS2812 pixels on pin 1, one per ladder pad (optional: -D EX_PIXELS)
  *
  * NOTE: Enable -D OC_LOG in platformio.ini build_flags to see debug output.
  *       Remove it for production (zero overhead, instant boot).
+ *
+ * NOTE: Optional hardware is off by default, so the example runs with just
+ *       the buttons and the encoder. Add its -D EX_<PART> flag in
+ *       platformio.ini once wired: without it, the part's stand-in keeps
+ *       its pins untouched (floating inputs would read as random events).
+ *
+ * NOTE: Add -D EX_TRACE to record an input-to-MIDI timeline; send 't' over
+ *       USB serial to dump it as Chrome trace JSON (open in ui.perfetto.dev).
+ *
+ * NOTE: Send 'c' over USB serial for the per-context CPU load table.
+ *
+ * NOTE: Run tools/latency_echo.py on the host to measure MIDI round-trip
+ *       latency; the device reports the distribution over SysEx.
+ *
+ * NOTE: Run tools/metrics_reader.py on the host to read the runtime metrics.
  */
 
+#include <algorithm>
 #include <optional>
 
 #include <oc/hal/teensy/Teensy.hpp>
 #include <oc/app/OpenControlApp.hpp>
 #include <oc/context/ContextBase.hpp>
 #include <oc/context/Requirements.hpp>
-#include <oc/hal/common/embedded/ButtonDef.hpp>
+#include <usb_dev.h>
+
+#include "AnalogLadderSource.hpp"
+#include "BackgroundScheduler.hpp"
+#include "ControllerSnapshot.hpp"
+#include "Clock.hpp"
+#include "CpuAccounting.hpp"
+#include "EncoderSource.hpp"
+#include "FsrSource.hpp"
+#include "GpioButtonSource.hpp"
+#include "InputPipeline.hpp"
+#include "LatencyProbe.hpp"
+#include "LedBank.hpp"
+#include "LedBus.hpp"
+#include "LoopMonitor.hpp"
+#include "MidiActions.hpp"
+#include "MidiPacketWriter.hpp"
+#include "Metrics.hpp"
+#include "MicroframeFlush.hpp"
+#include "PersistentState.hpp"
+#include "ToggleBank.hpp"
+#include "TouchButtonSource.hpp"
+#include "Trace.hpp"
+#include "Ws2812Output.hpp"
+
+#ifdef EX_DISPLAY
+#include "ButtonPanelView.hpp"
+#endif
 
 // ═══════════════════════════════════════════════════════════════════════════
 // Configuration - Adapt to your hardware
@@ -41,18 +117,241 @@ namespace Config {
     constexpr uint8_t MIDI_CHANNEL = 0;
     constexpr uint8_t BUTTON1_CC = 20;
     constexpr uint8_t BUTTON2_CC = 21;
+    constexpr uint8_t ENCODER_CC = 22;
+    constexpr int ENCODER_COARSE_STEP = 8;  // Per detent; hold Button 1 for steps of 1
 
     constexpr uint32_t LONG_PRESS_MS = 500;
     constexpr uint32_t DOUBLE_TAP_MS = 300;
     constexpr uint8_t DEBOUNCE_MS = 5;
 
-    // Button hardware definitions - ADAPT pins to your wiring
-    constexpr std::array<oc::hal::common::embedded::ButtonDef, 2> BUTTONS = {{
-        oc::hal::common::embedded::ButtonDef(1, oc::hal::common::embedded::GpioPin{32, oc::hal::common::embedded::GpioPin::Source::MCU}, true),  // ADAPT: pin 32
-        oc::hal::common::embedded::ButtonDef(2, oc::hal::common::embedded::GpioPin{35, oc::hal::common::embedded::GpioPin::Source::MCU}, true),  // ADAPT: pin 35
+    // Toggle/radio bits owned by the input layer (persisted as 1 byte per 8)
+    constexpr size_t TOGGLE_SLOTS = 8;
+
+    // Loop health: ticks longer than this are reported, the watchdog resets hard hangs
+    constexpr uint32_t LOOP_OVERRUN_US = 2000;
+    constexpr uint32_t WATCHDOG_TIMEOUT_MS = 500;
+
+    // CPU budgets per tick: feedback (LEDs, display) waits a tick when update() is over
+    constexpr uint32_t MAIN_UPDATE_BUDGET_US = 1000;
+    constexpr uint32_t MAIN_POLL_BUDGET_US = 100;       // Source scans (touch: up to 20 us)
+    constexpr uint32_t MAIN_HANDLERS_BUDGET_US = 500;   // Event dispatch and bindings
+
+    // Latency test (started by the host): one probe per 10 ms, lost after 100 ms
+    constexpr uint32_t LATENCY_PROBE_INTERVAL_US = 10000;
+    constexpr uint32_t LATENCY_PROBE_TIMEOUT_US = 100000;
+
+    // Persistent state journal: 64 records x 4 bytes at the start of EEPROM
+    constexpr uint16_t STATE_EEPROM_BASE = 0;
+    constexpr uint16_t STATE_JOURNAL_SLOTS = 64;
+
+    // DAW resync burst: 4 CCs per batch, one batch per millisecond at most
+    constexpr size_t MAX_CONTROLLERS = 16;
+    constexpr uint8_t RESYNC_BATCH = 4;
+    constexpr uint32_t RESYNC_INTERVAL_US = 1000;
+
+#ifdef EX_DISPLAY
+    // ILI9341 display on SPI0 - ADAPT pins to your wiring
+    constexpr example::ButtonPanelView::Pins DISPLAY_PINS{
+        .cs = 9, .dc = 10, .sck = 13, .mosi = 11, .miso = 12, .reset = 6
+    };
+    constexpr uint32_t DISPLAY_SPI_HZ = 30000000;
+#endif
+
+    // Button LEDs: one 74HC595 on SPI1 (MOSI 26, SCK 27) - ADAPT latch pin.
+    // MISO is unused but claimed: moved to 39, off the pixels on pin 1
+    constexpr size_t LED_COUNT = 8;
+    constexpr uint8_t LED_LATCH_PIN = 28;
+    constexpr uint8_t LED_MISO_PIN = 39;
+    constexpr uint32_t LED_SPI_HZ = 4000000;
+    constexpr uint32_t LED_BAM_UNIT_US = 250;  // 4-bit BAM: 3.75 ms cycle, ~270 Hz
+    constexpr uint8_t LED_HEARTBEAT = 3;       // Breathes while the firmware runs
+
+    // Background contexts: tick periods, and their total time per loop()
+    constexpr uint32_t LED_REFRESH_US = 125;
+    constexpr uint32_t HEARTBEAT_PERIOD_US = 20000;
+    constexpr uint32_t BACKGROUND_BUDGET_US = 200;
+
+    // WS2812 pixels on Serial1 TX (pin 1), one per ladder pad; colors are 0xRRGGBB
+    constexpr size_t PIXEL_COUNT = 8;
+    constexpr uint32_t PIXEL_IDLE = 0x000010;
+    constexpr uint32_t PIXEL_IDLE_TOGGLED = 0x100800;
+    constexpr uint32_t PIXEL_PRESSED = 0x606060;
+
+    // Unified input stream: event queue and binding table sizes
+    constexpr size_t INPUT_QUEUE_SIZE = 32;
+    constexpr size_t INPUT_MAX_BINDINGS = 16;
+
+    // Rotary encoder - ADAPT pins to your wiring (push switch is Button 3)
+    constexpr example::EncoderDef ENCODER{
+        .id = 1, .pinA = 2, .pinB = 3, .pushButtonId = 3, .countsPerStep = 4
+    };
+
+    // Resistor ladder on A0 - ADAPT centers to your resistor values (10-bit ADC)
+    constexpr example::LadderDef<8> LADDER{
+        .pin = A0,
+        .ids = {11, 12, 13, 14, 15, 16, 17, 18},
+        .centers = {0, 128, 256, 384, 512, 640, 768, 896},
+        .idle = 1023,
+        .hysteresis = 16
+    };
+    constexpr uint8_t LADDER_FIRST_NOTE = 60;
+
+    // Touch pads - ADAPT pins to your wiring; measured one pad per tick
+    constexpr std::array<example::TouchPad, 2> TOUCH_PADS = {{
+        {.id = 21, .pin = 24},
+        {.id = 22, .pin = 25},
+    }};
+    constexpr uint32_t TOUCH_TIMEOUT_CYCLES = 12000;  // 20 us at 600 MHz: per-tick cost cap
+    constexpr uint8_t TOUCH_FIRST_CC = 23;
+
+    // FSR pads on ADC2 - ADAPT pins and ADC2 channels to your wiring
+    constexpr std::array<example::FsrPad, 2> FSR_PADS = {{
+        {.id = 25, .pin = A1, .adc2Channel = 8},
+        {.id = 26, .pin = A2, .adc2Channel = 12},
+    }};
+    constexpr uint8_t FSR_NOTE = 72;
+    constexpr uint8_t FSR_CC = 25;
+
+    // Plain button-to-MIDI mappings, declared as data (see MidiActions.hpp)
+    constexpr std::array<example::MidiAction, 15> ACTIONS = {{
+        example::momentaryCC(1, MIDI_CHANNEL, BUTTON1_CC),           // Button 1: 127 / 0
+        example::sendCC(ENCODER.pushButtonId, MIDI_CHANNEL, ENCODER_CC, 64),  // Encoder push: recenter
+        example::sendNote(11, MIDI_CHANNEL, LADDER_FIRST_NOTE + 0, 100),      // Ladder pads: notes
+        example::sendNote(12, MIDI_CHANNEL, LADDER_FIRST_NOTE + 1, 100),
+        example::sendNote(13, MIDI_CHANNEL, LADDER_FIRST_NOTE + 2, 100),
+        example::sendNote(14, MIDI_CHANNEL, LADDER_FIRST_NOTE + 3, 100),
+        example::sendNote(15, MIDI_CHANNEL, LADDER_FIRST_NOTE + 4, 100),
+        example::sendNote(16, MIDI_CHANNEL, LADDER_FIRST_NOTE + 5, 100),
+        example::sendNote(17, MIDI_CHANNEL, LADDER_FIRST_NOTE + 6, 100),
+        example::sendNote(18, MIDI_CHANNEL, LADDER_FIRST_NOTE + 7, 100),
+        example::momentaryCC(21, MIDI_CHANNEL, TOUCH_FIRST_CC + 0),   // Touch pads: 127 / 0
+        example::momentaryCC(22, MIDI_CHANNEL, TOUCH_FIRST_CC + 1),
+        example::sendNote(25, MIDI_CHANNEL, FSR_NOTE, 100),           // FSR 1: note + aftertouch
+        example::aftertouch(25, MIDI_CHANNEL, FSR_NOTE),
+        example::pressureCC(26, MIDI_CHANNEL, FSR_CC),                // FSR 2: pressure as CC
+    }};
+
+    // Button wiring - ADAPT pins to your wiring
+    constexpr std::array<example::ButtonPin, 3> BUTTON_PINS = {{
+        {.id = 1, .pin = 32, .activeLow = true},  // ADAPT: pin 32
+        {.id = 2, .pin = 35, .activeLow = true},  // ADAPT: pin 35
+        {.id = 3, .pin = 4, .activeLow = true},   // ADAPT: encoder switch, pin 4
     }};
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// DMA buffers
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifdef EX_DISPLAY
+// Display framebuffers (150 KB each: the driver copy lives in DMAMEM)
+uint16_t displayFb[example::ButtonPanelView::WIDTH * example::ButtonPanelView::HEIGHT];
+DMAMEM uint16_t displayInternalFb[example::ButtonPanelView::WIDTH * example::ButtonPanelView::HEIGHT];
+#endif
+
+#ifdef EX_LADDER
+// Ladder ADC samples, written by DMA (plain global: DTCM, not cached)
+volatile uint16_t ladderSamples[16];
+#endif
+
+#ifdef EX_PIXELS
+// WS2812 bitstream, read by DMA
+uint8_t pixelStream[example::Ws2812Output<Config::PIXEL_COUNT>::BYTES];
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Stand-ins for optional hardware that is not enabled
+// ═══════════════════════════════════════════════════════════════════════════
+// Same interface as the real part, every call compiles away: the context
+// reads the same with or without the hardware.
+
+#ifndef EX_DISPLAY
+/// No screen: widget updates are dropped
+struct NoDisplay {
+    void setPressed(uint8_t, bool) {}
+    void setToggle(bool) {}
+    void setLongPressProgress(uint8_t) {}
+    void service() {}
+};
+#endif
+
+#ifndef EX_LEDS
+/// No shift register: the LED bank still runs, its flushes go nowhere
+struct NoLedBus {
+    void begin() {}
+    void write(const uint8_t*, size_t) {}
+};
+#endif
+
+#ifndef EX_PIXELS
+/// No pixels: colors are kept so the pad logic reads the same, never sent
+struct NoPixels {
+    void begin() {}
+    void setTracer(example::Tracer*) {}
+    void set(size_t pixel, uint32_t rgb) { colors[pixel] = rgb; }
+    uint32_t get(size_t pixel) const { return colors[pixel]; }
+    bool service(uint32_t) { return false; }
+    std::array<uint32_t, Config::PIXEL_COUNT> colors{};
+};
+#endif
+
+/// No hardware behind an input source: nothing to sample, no events
+struct NoInput {
+    void begin() {}
+    void setTracer(example::Tracer*) {}
+    template <typename Pipeline>
+    void poll(Pipeline&, uint32_t) {}
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Runtime services
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Host SysEx, routed to the context that listens for it
+ *
+ * usbMIDI only takes a plain function: setup() installs one forwarding here.
+ */
+class SysExRoute {
+public:
+    using Handler = void (*)(void* user, const uint8_t* data, size_t size);
+
+    void listen(Handler handler, void* user) {
+        handler_ = handler;
+        user_ = user;
+    }
+
+    void deliver(const uint8_t* data, size_t size) {
+        if (handler_) handler_(user_, data, size);
+    }
+
+private:
+    Handler handler_ = nullptr;
+    void* user_ = nullptr;
+};
+
+/**
+ * @brief Everything contexts share, handed to each one at construction
+ *
+ * Contexts use what they are given, never a global: on the host the same
+ * contexts run against a virtual clock and their own instances.
+ */
+struct Runtime {
+    example::Clock clock = example::Clock::of<micros>();
+    example::LoopMonitor loopMonitor{clock, Config::LOOP_OVERRUN_US};  // Wraps every loop() iteration
+    example::CpuAccounting<> cpu;                                      // One set of accounts per context
+    // Shared outputs: written by any context, refreshed in the background
+    example::LedBank<Config::LED_COUNT> leds{Config::LED_BAM_UNIT_US};
+#ifdef EX_LEDS
+    example::ShiftRegisterBus ledBus{SPI1, Config::LED_LATCH_PIN, Config::LED_MISO_PIN, Config::LED_SPI_HZ};
+#else
+    NoLedBus ledBus;
+#endif
+    example::BackgroundScheduler<> background{clock};
+    SysExRoute sysex;
+    example::Tracer* tracer = nullptr;  ///< Null unless built with EX_TRACE
+};
+
 // ═══════════════════════════════════════════════════════════════════════════
 // Context ID (user-defined)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -72,57 +371,455 @@ enum class ContextID : uint8_t { MAIN = 0 };
 class MainContext : public oc::context::ContextBase {
 public:
     // Declare required APIs (validated at registration)
+    // Buttons and encoders are read by our own sources into our own
+    // pipeline, not through the framework API
     static constexpr oc::context::Requirements REQUIRES{
-        .button = true,
+        .button = false,
         .encoder = false,
         .midi = true
     };
 
+    explicit MainContext(Runtime& runtime) : rt_(runtime) {}
+
     oc::type::Result<void> init() override {
-        // Button 1: Press/Release (momentary)
-        onButton(1).press().then([this]() {
-            midi().sendCC(Config::MIDI_CHANNEL, Config::BUTTON1_CC, 127);
-            OC_LOG_DEBUG("Button 1: Press -> CC 127");
-        });
+        cpuUpdate_ = rt_.cpu.add("main.update", Config::MAIN_UPDATE_BUDGET_US);
+        cpuPoll_ = rt_.cpu.add("main.poll", Config::MAIN_POLL_BUDGET_US);
+        cpuHandlers_ = rt_.cpu.add("main.handlers", Config::MAIN_HANDLERS_BUDGET_US);
+        auto cpuScope = rt_.cpu.measure(rt_.cpu.add("main.init"));
+
+        // Restore persisted state (bounded: a fixed number of passes over the journal)
+        state_.begin();
+        for (size_t i = 0; i < Toggles::BYTES; ++i) {
+            toggles_.setByte(i, state_.get(static_cast<uint8_t>(KEY_TOGGLES + i)));
+        }
+        const bool toggled = toggles_.get(SLOT_BUTTON2);
+
+#ifdef EX_DISPLAY
+        if (!view_.begin(Config::DISPLAY_SPI_HZ)) {
+            OC_LOG_INFO("Display not found - running without visual feedback");
+        }
+#endif
+        view_.setToggle(toggled);
+
+        rt_.leds.setOn(LED_BUTTON2, toggled);
 
-        onButton(1).release().then([this]() {
-            midi().sendCC(Config::MIDI_CHANNEL, Config::BUTTON1_CC, 0);
-            OC_LOG_DEBUG("Button 1: Release -> CC 0");
+        pixels_.begin();
+        paintPads();
+
+        // Register every controller we drive (toggle state first on resync)
+        snapshot_.add(Config::MIDI_CHANNEL, Config::BUTTON1_CC, 1);
+        button2Cc_ = snapshot_.add(Config::MIDI_CHANNEL, Config::BUTTON2_CC, 0, toggled ? 127 : 0);
+        encoderCc_ = snapshot_.add(Config::MIDI_CHANNEL, Config::ENCODER_CC, 1, 64);
+        snapshot_.add(Config::MIDI_CHANNEL, Config::FSR_CC, 1);  // Pressure CC: at most one per tick
+        rt_.leds.set(LED_ENCODER, static_cast<uint8_t>(snapshot_.value(encoderCc_) * 2));
+
+        // Button edges are scanned here and join the encoder events in one
+        // stream, which also resolves the gestures (long press, double tap)
+        buttons_.begin();
+        ladder_.begin();
+        touch_.begin();
+        fsr_.begin();
+
+        // Button 1: momentary CC from Config::ACTIONS, long press to resync.
+        // It is also the fine-adjust modifier (below): the CC follows the
+        // button as usual, but a hold that turned the encoder does not resync
+        input_.onButton(1).longPress().then([this]() {
+            EX_TRACE_INSTANT(rt_.tracer, "longPress", 1);
+            snapshot_.requestResync();
+            OC_LOG_DEBUG("Button 1: Long press -> Resync");
         });
 
-        onButton(1).longPress(Config::LONG_PRESS_MS).then([]() {
-            OC_LOG_DEBUG("Button 1: Long press!");
+        // Button 2: Toggle behavior (state bit lives in toggles_, see onToggle())
+        toggles_.bindToggle(2, SLOT_BUTTON2);
+
+        input_.onButton(2).press().then([this]() {
+            view_.setPressed(2, true);
         });
 
-        // Button 2: Toggle behavior
-        onButton(2).press().then([this]() {
-            toggle_ = !toggle_;
-            uint8_t value = toggle_ ? 127 : 0;
-            midi().sendCC(Config::MIDI_CHANNEL, Config::BUTTON2_CC, value);
-            OC_LOG_DEBUG("Button 2: Toggle -> CC {}", value);
+        input_.onButton(2).release().then([this]() {
+            view_.setPressed(2, false);
         });
 
-        onButton(2).doubleTap(Config::DOUBLE_TAP_MS).then([this]() {
-            toggle_ = false;
-            midi().sendCC(Config::MIDI_CHANNEL, Config::BUTTON2_CC, 0);
+        input_.onButton(2).doubleTap().then([this]() {
+            EX_TRACE_INSTANT(rt_.tracer, "doubleTap", 2);
+            toggles_.set(SLOT_BUTTON2, false, [this](uint16_t slot, bool on) { onToggle(slot, on); });
             OC_LOG_DEBUG("Button 2: Double tap -> Reset");
         });
 
+        // Encoder: coarse steps, fine steps while Button 1 is held, push to recenter
+        input_.onEncoder(Config::ENCODER.id).turn().then([this](const example::InputEvent& e) {
+            nudgeEncoder(e.delta * Config::ENCODER_COARSE_STEP);
+        });
+
+        input_.onButton(1).held().onEncoder(Config::ENCODER.id).turn().then([this](const example::InputEvent& e) {
+            nudgeEncoder(e.delta);
+        });
+
+        // Announce the restored state to the host
+        snapshot_.requestResync();
+
+        // Attribute handler time to its binding when a tick overruns; the
+        // rest of dispatch (action table, toggles) goes back to "dispatch"
+        input_.setHandlerProbe(
+            [](void* monitor, uint16_t key) { static_cast<example::LoopMonitor*>(monitor)->stage("binding", key); },
+            [](void* monitor) { static_cast<example::LoopMonitor*>(monitor)->stage("dispatch"); },
+            &rt_.loopMonitor);
+
+        // Metrics queries, resync requests and latency-test traffic
+        rt_.sysex.listen([](void* self, const uint8_t* data, size_t size) {
+            static_cast<MainContext*>(self)->onSysEx(data, size);
+        }, this);
+
+        input_.setTracer(rt_.tracer);
+        buttons_.setTracer(rt_.tracer);
+        ladder_.setTracer(rt_.tracer);
+        touch_.setTracer(rt_.tracer);
+        fsr_.setTracer(rt_.tracer);
+        pixels_.setTracer(rt_.tracer);
+#ifdef EX_TRACE
+        if (rt_.tracer) OC_LOG_INFO("Trace overhead: {} cycles/event", rt_.tracer->calibrate());
+#endif
+
         return oc::type::Result<void>::ok();
     }
 
-    void update() override {}
+    void update() override {
+        EX_TRACE_SCOPE(rt_.tracer, "update");
+        const uint32_t nowUs = now();
+
+        {
+            auto cpuScope = rt_.cpu.measure(cpuUpdate_);
+
+            // All input, buttons and encoder alike, in one pass. Scans and
+            // handlers are accounted apart: a slow source is not a slow binding
+            {
+                EX_TRACE_SCOPE(rt_.tracer, "dispatch");
+                rt_.loopMonitor.stage("dispatch");
+                {
+                    auto pollScope = rt_.cpu.measure(cpuPoll_);
+                    buttons_.poll(input_, nowUs);
+                    ladder_.poll(input_, nowUs);
+                    touch_.poll(input_, nowUs);
+                    fsr_.poll(input_, nowUs);
+                    encoder_.poll(input_, nowUs);
+                }
+                auto handlersScope = rt_.cpu.measure(cpuHandlers_);
+                metrics_.countEvents(input_.dispatch(nowUs, [this](const example::InputEvent& e) {
+                    toggles_.handle(e, [this](uint16_t slot, bool on) { onToggle(slot, on); });
+                    actions_.run(e, [this](const example::MidiMessage& m) { sendAction(m); });
+                    showPad(e);
+                }));
+            }
+
+            // Handlers only touch the RAM mirror: the journal is written here,
+            // at most one EEPROM byte per tick, after dispatch. A byte usually
+            // takes microseconds, but the EEPROM emulation occasionally erases
+            // a flash sector first: that tick then stalls for tens of ms
+            rt_.loopMonitor.stage("persist");
+            state_.service();
+
+            // Changed parameters go out once, right after dispatch; then the
+            // resync burst, in small batches, only on ticks without live traffic.
+            // Written packets (notes included) are committed once per USB
+            // microframe: on the first tick that sees a new one
+            rt_.loopMonitor.stage("midi");
+            // The host (re)configured the USB device: the DAW lost our state
+            const bool usbConfigured = usb_configuration != 0;
+            if (usbConfigured && !usbConfigured_) snapshot_.requestResync();
+            usbConfigured_ = usbConfigured;
+            auto send = [this](uint8_t channel, uint8_t cc, uint8_t value) { sendCC(channel, cc, value); };
+            snapshot_.flush(send);
+            snapshot_.service(nowUs, send);
+            const uint16_t microframe = example::usbMicroframe();
+            if (midiFlush_.mayCommit(microframe)) {
+                packets_.commit();
+                midiFlush_.committed(microframe, now());
+            }
+
+            // Latency test: probes are committed at once, they time the wire,
+            // not the microframe queue (pending output leaves with them)
+            rt_.loopMonitor.stage("latency");
+            auto sendProbe = [this, microframe](const uint8_t* data, size_t size) {
+                sendSysEx(data, size);
+                packets_.commit();
+                midiFlush_.committed(microframe, now());
+            };
+            if (latency_.service(nowUs, sendProbe)) {
+                uint8_t report[Latency::REPORT_MAX];
+                sendSysEx(report, latency_.encodeReport(report));
+            }
+
+            rt_.loopMonitor.stage("metrics");
+            metrics_.setDropped(input_.dropped());
+            metrics_.setQueueHighWater(input_.highWater());
+            metrics_.setMidiQueueDelay(midiFlush_.maxDelayUs(), midiFlush_.meanDelayUs());
+            metrics_.tick(nowUs);
+            uptimeUs_ += nowUs - uptimeAtUs_;  // From the injected clock, past its 32-bit wrap
+            uptimeAtUs_ = nowUs;
+            if (metricsRequested_) {
+                metricsRequested_ = false;
+                uint8_t message[example::Metrics::RESPONSE_MAX];
+                sendSysEx(message, example::Metrics::encodeResponse(metrics_.snapshot(static_cast<uint32_t>(uptimeUs_ / 1000)), message));
+            }
+        }
+
+        // Feedback can wait a tick: skipped when input and MIDI used the budget
+        if (rt_.cpu.overBudget(cpuUpdate_)) return;
+        auto cpuScope = rt_.cpu.measure(cpuUpdate_);
+
+        // Pixel state written by handlers during dispatch goes out here:
+        // one DMA start, never a wait (button LEDs: see LedRefresh)
+        rt_.loopMonitor.stage("pixels");
+        pixels_.service(nowUs);
+
+        // Button 1 as pressed physically; the long-press progress fills
+        // while it is held, unless the hold is being used as a modifier
+        const uint32_t button1 = 1u << 1;
+        const bool button1Held = input_.heldMask() & button1;
+        if (button1Held != button1Held_) {
+            button1Held_ = button1Held;
+            view_.setPressed(1, button1Held);
+            rt_.leds.setOn(LED_BUTTON1, button1Held);
+        }
+        uint32_t held = button1Held && !(input_.modifyingMask() & button1)
+            ? (nowUs - input_.pressedAtUs(1)) / 1000 : 0;
+        rt_.loopMonitor.stage("display");
+        view_.setLongPressProgress(
+            static_cast<uint8_t>(std::min<uint32_t>(held, Config::LONG_PRESS_MS) * 255 / Config::LONG_PRESS_MS));
+        view_.service();
+    }
 
     const char* getName() const override { return "Main"; }
 
 private:
-    bool toggle_ = false;
+    using Toggles = example::ToggleBank<Config::TOGGLE_SLOTS>;
+    enum ToggleSlot : uint16_t { SLOT_BUTTON2 = 0 };
+    enum StateKey : uint8_t { KEY_TOGGLES = 0, KEY_COUNT = KEY_TOGGLES + Toggles::BYTES };
+    using Snapshot = example::ControllerSnapshot<Config::MAX_CONTROLLERS>;
+    using Latency = example::LatencyProbe<>;
+    enum Led : uint8_t { LED_BUTTON1 = 0, LED_BUTTON2 = 1, LED_ENCODER = 2 };
+
+    /// Set a parameter; it is sent by the next flush() only if it changed.
+    /// The encoder LED follows its CC however it is set (turn, push, action)
+    void setParameter(Snapshot::Id id, uint8_t value) {
+        snapshot_.set(id, value);
+        if (id == encoderCc_) rt_.leds.set(LED_ENCODER, static_cast<uint8_t>(value * 2));
+    }
+
+    /// Channel messages bypass midi(): one packet store each, sent at the microframe commit
+    void sendPacket(uint32_t packet) {
+        packets_.write(packet);
+        midiFlush_.noteWrite(now());
+        metrics_.countMidiBytes(3);
+    }
+
+    /// SysEx replies take the same path, committed with the next microframe
+    void sendSysEx(const uint8_t* data, size_t size) {
+        packets_.writeSysEx(data, size);
+        midiFlush_.noteWrite(now());
+        metrics_.countMidiBytes(size);
+    }
+
+    void sendCC(uint8_t channel, uint8_t cc, uint8_t value) {
+        EX_TRACE_INSTANT(rt_.tracer, "sendCC", cc, value);
+        sendPacket(example::packet::cc(channel, cc, value));
+    }
+
+    /// A toggle bit flipped: persist it, show it, send it
+    void onToggle(uint16_t slot, bool on) {
+        state_.set(static_cast<uint8_t>(KEY_TOGGLES + slot / 8), toggles_.byte(slot / 8));
+        if (slot == SLOT_BUTTON2) {
+            view_.setToggle(on);
+            rt_.leds.setOn(LED_BUTTON2, on);
+            paintPads();
+            setParameter(button2Cc_, on ? 127 : 0);
+            OC_LOG_DEBUG("Button 2: Toggle -> CC {}", on ? 127 : 0);
+        }
+    }
+
+    /// Ladder pad pixel follows its pad
+    void showPad(const example::InputEvent& e) {
+        const uint8_t first = Config::LADDER.ids[0];
+        if (e.source != example::InputSource::BUTTON || e.id < first || e.id >= first + Config::PIXEL_COUNT) return;
+        if (e.type == example::InputType::PRESS) pixels_.set(e.id - first, Config::PIXEL_PRESSED);
+        else if (e.type == example::InputType::RELEASE) pixels_.set(e.id - first, idleColor());
+    }
+
+    /// Idle pad color reflects the Button 2 toggle
+    void paintPads() {
+        for (size_t i = 0; i < Config::PIXEL_COUNT; ++i) {
+            if (pixels_.get(i) != Config::PIXEL_PRESSED) pixels_.set(i, idleColor());
+        }
+    }
+
+    uint32_t idleColor() const {
+        return toggles_.get(SLOT_BUTTON2) ? Config::PIXEL_IDLE_TOGGLED : Config::PIXEL_IDLE;
+    }
+
+    /// Output of the declarative action table
+    void sendAction(const example::MidiMessage& m) {
+        switch (m.kind) {
+            case example::MidiMessage::Kind::CC: {
+                Snapshot::Id id = snapshot_.find(m.channel, m.number);
+                if (id != Snapshot::INVALID) {
+                    setParameter(id, m.value);
+                } else {
+                    snapshot_.noteInteractive();
+                    sendCC(m.channel, m.number, m.value);
+                }
+                OC_LOG_DEBUG("Action: CC {} -> {}", m.number, m.value);
+                break;
+            }
+            case example::MidiMessage::Kind::NOTE_ON:
+                snapshot_.noteInteractive();
+                sendPacket(example::packet::noteOn(m.channel, m.number, m.value));
+                break;
+            case example::MidiMessage::Kind::NOTE_OFF:
+                snapshot_.noteInteractive();
+                sendPacket(example::packet::noteOff(m.channel, m.number, 0));
+                break;
+            case example::MidiMessage::Kind::POLY_PRESSURE:
+                snapshot_.noteInteractive();
+                sendPacket(example::packet::polyPressure(m.channel, m.number, m.value));
+                break;
+        }
+    }
+
+    /// Every timestamp in this context comes from here, never from a global
+    uint32_t now() const { return rt_.clock.nowUs(); }
+
+    void onSysEx(const uint8_t* data, size_t size) {
+        uint32_t probes = 0;
+        if (example::Metrics::isQuery(data, size)) {
+            metricsRequested_ = true;
+        } else if (example::Metrics::isCommand(data, size, example::Metrics::SYSEX_RESYNC)) {
+            snapshot_.requestResync();
+        } else if (Latency::isStart(data, size, probes)) {
+            latency_.start(probes);
+        } else {
+            latency_.onEcho(data, size, now());
+        }
+    }
+
+    void nudgeEncoder(int delta) {
+        int value = std::clamp(snapshot_.value(encoderCc_) + delta, 0, 127);
+        setParameter(encoderCc_, static_cast<uint8_t>(value));
+    }
+
+    Runtime& rt_;
+    example::Metrics metrics_;
+    example::MidiPacketWriter<example::UsbMidiPort> packets_;
+    example::MicroframeFlush midiFlush_;
+    bool metricsRequested_ = false;
+    uint64_t uptimeUs_ = 0;
+    uint32_t uptimeAtUs_ = 0;
+    example::CpuAccounting<>::Id cpuUpdate_ = example::CpuAccounting<>::INVALID;
+    example::CpuAccounting<>::Id cpuPoll_ = example::CpuAccounting<>::INVALID;
+    example::CpuAccounting<>::Id cpuHandlers_ = example::CpuAccounting<>::INVALID;
+    Latency latency_{Config::LATENCY_PROBE_INTERVAL_US, Config::LATENCY_PROBE_TIMEOUT_US};
+    Toggles toggles_;
+    bool button1Held_ = false;
+#ifdef EX_DISPLAY
+    example::ButtonPanelView view_{Config::DISPLAY_PINS, displayFb, displayInternalFb};
+#else
+    NoDisplay view_;
+#endif
+#ifdef EX_PIXELS
+    example::Ws2812Output<Config::PIXEL_COUNT> pixels_{pixelStream};
+#else
+    NoPixels pixels_;
+#endif
+    Snapshot snapshot_{{.maxPerBatch = Config::RESYNC_BATCH, .intervalUs = Config::RESYNC_INTERVAL_US}};
+    Snapshot::Id button2Cc_ = Snapshot::INVALID;
+    Snapshot::Id encoderCc_ = Snapshot::INVALID;
+    bool usbConfigured_ = false;
+    example::InputPipeline<Config::INPUT_QUEUE_SIZE, Config::INPUT_MAX_BINDINGS> input_{
+        {.longPressUs = Config::LONG_PRESS_MS * 1000, .doubleTapUs = Config::DOUBLE_TAP_MS * 1000}};
+    example::EncoderSource encoder_{Config::ENCODER};
+#ifdef EX_LADDER
+    example::AnalogLadderSource<8> ladder_{Config::LADDER, ladderSamples, Config::DEBOUNCE_MS * 1000u};
+#else
+    NoInput ladder_;  // An unconnected A0 floats: random pad presses
+#endif
+#ifdef EX_TOUCH
+    example::TouchButtonSource<Config::TOUCH_PADS.size()> touch_{
+        Config::TOUCH_PADS, Config::TOUCH_TIMEOUT_CYCLES, Config::DEBOUNCE_MS * 1000u};
+#else
+    NoInput touch_;  // No pads: 20 us of masked interrupts per tick for nothing
+#endif
+#ifdef EX_FSR
+    example::FsrSource<Config::FSR_PADS.size()> fsr_{Config::FSR_PADS};
+#else
+    NoInput fsr_;  // Unconnected A1/A2 float: random notes and aftertouch
+#endif
+    example::ActionTable<Config::ACTIONS.size()> actions_{Config::ACTIONS};
+    example::GpioButtonSource<Config::BUTTON_PINS.size(), Config::BUTTON_PINS> buttons_{Config::DEBOUNCE_MS * 1000u};
+    example::PersistentState<KEY_COUNT, Config::STATE_JOURNAL_SLOTS,
+                             example::EepromStorage<Config::STATE_EEPROM_BASE>> state_;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Background Contexts
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Flushes the button LEDs (BAM planes need a steady refresh)
+ *
+ * Runs whatever the foreground context; contexts only write leds.
+ */
+class LedRefresh : public example::BackgroundContext {
+public:
+    explicit LedRefresh(Runtime& runtime) : rt_(runtime) {}
+
+    void init() override {
+        account_ = rt_.cpu.add("bg.leds");
+        rt_.ledBus.begin();
+    }
+
+    void tick(uint32_t nowUs) override {
+        auto cpuScope = rt_.cpu.measure(account_);
+        rt_.leds.flush(rt_.ledBus, nowUs);
+    }
+
+    const char* name() const override { return "LedRefresh"; }
+
+private:
+    Runtime& rt_;
+    example::CpuAccounting<>::Id account_ = example::CpuAccounting<>::INVALID;
+};
+
+/// Triangle-wave "alive" LED, 2 s per breath
+class Heartbeat : public example::BackgroundContext {
+public:
+    explicit Heartbeat(Runtime& runtime) : rt_(runtime) {}
+
+    void init() override { account_ = rt_.cpu.add("bg.heartbeat"); }
+
+    void tick(uint32_t nowUs) override {
+        auto cpuScope = rt_.cpu.measure(account_);
+        const uint32_t phase = (nowUs / 1000) % 2000;
+        const uint32_t level = phase < 1000 ? phase : 2000 - phase;
+        rt_.leds.set(Config::LED_HEARTBEAT, static_cast<uint8_t>(level * 255 / 1000));
+    }
+
+    const char* name() const override { return "Heartbeat"; }
+
+private:
+    Runtime& rt_;
+    example::CpuAccounting<>::Id account_ = example::CpuAccounting<>::INVALID;
 };
 
 // ═══════════════════════════════════════════════════════════════════════════
 // Global Application
 // ═══════════════════════════════════════════════════════════════════════════
+// The only globals: created here, handed out by setup()
 
+#ifdef EX_TRACE
+example::Tracer traceBuffer;
+#endif
+Runtime runtime;
+LedRefresh ledRefresh{runtime};
+Heartbeat heartbeat{runtime};
 std::optional<oc::app::OpenControlApp> app;
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -131,21 +828,67 @@ std::optional<oc::app::OpenControlApp> app;
 
 void setup() {
     OC_LOG_INFO("Example 03: Buttons");
+    if (example::LoopMonitor::resetByWatchdog()) {
+        OC_LOG_INFO("Recovered from a watchdog reset");
+    }
+
+#ifdef EX_TRACE
+    runtime.tracer = &traceBuffer;
+#endif
+    usbMIDI.setHandleSystemExclusive([](uint8_t* data, unsigned int size) {
+        runtime.sysex.deliver(data, size);
+    });
 
     app = oc::hal::teensy::AppBuilder()
-        .midi()
-        .buttons(Config::BUTTONS, Config::DEBOUNCE_MS)
-        .inputConfig({
-            .longPressMs = Config::LONG_PRESS_MS,
-            .doubleTapWindowMs = Config::DOUBLE_TAP_MS
-        });
+        .midi();
 
-    app->registerContext<MainContext>(ContextID::MAIN, "Main");
+    app->registerContext<MainContext>(ContextID::MAIN, "Main", runtime);
     app->begin();
 
+    // Background contexts: no bindings, ticked after every foreground update
+    runtime.background.add(ledRefresh, Config::LED_REFRESH_US);
+    runtime.background.add(heartbeat, Config::HEARTBEAT_PERIOD_US);
+    runtime.background.begin();
+
+    runtime.loopMonitor.enableWatchdog(Config::WATCHDOG_TIMEOUT_MS);
     OC_LOG_INFO("Ready");
 }
 
 void loop() {
+    runtime.loopMonitor.beginTick();
     app->update();
+    runtime.loopMonitor.stage("background");
+    runtime.background.service(Config::BACKGROUND_BUDGET_US);
+    runtime.loopMonitor.endTick();
+    runtime.cpu.endTick(runtime.clock.nowUs());
+
+    // USB serial commands
+    if (Serial.available()) {
+        switch (Serial.read()) {
+            case 'c':
+                runtime.cpu.print(Serial);
+                break;
+#ifdef EX_TRACE
+            case 't':
+                traceBuffer.writeChromeJson(Serial);
+                traceBuffer.clear();
+                break;
+#endif
+        }
+    }
+
+#ifdef OC_LOG
+    static uint32_t reportedOverruns = 0;
+    const auto& overrun = runtime.loopMonitor.lastOverrun();
+    if (overrun.count != reportedOverruns) {
+        reportedOverruns = overrun.count;
+        OC_LOG_INFO("Overrun: tick {} us, slowest stage {}({}) {} us",
+                    overrun.tickUs, overrun.stage, overrun.stageArg, overrun.stageUs);
+    }
+    static uint32_t reportedOverBudget = 0;
+    if (runtime.cpu.overBudgetTicks() != reportedOverBudget) {
+        reportedOverBudget = runtime.cpu.overBudgetTicks();
+        OC_LOG_INFO("CPU budget exceeded ({} ticks total) - send 'c' for details", reportedOverBudget);
+    }
+#endif
 }
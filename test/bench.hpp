@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * @file bench.hpp
+ * @brief Minimal timing loop for the host benchmarks
+ *
+ * bench::run() repeats a callable, keeps the fastest of a few rounds and
+ * prints ns per call. Host numbers compare variants of the same code; they
+ * are not Teensy timings.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace bench {
+
+/// Keep a value alive so the optimizer cannot drop the work producing it
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// @return Fastest round, in ns per call
+template <typename Fn>
+double run(const char* name, uint32_t calls, Fn&& fn) {
+    using clock = std::chrono::steady_clock;
+    double best = 1e30;
+    for (int round = 0; round < 5; ++round) {
+        const auto start = clock::now();
+        for (uint32_t i = 0; i < calls; ++i) fn(i);
+        const double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / calls;
+        if (ns < best) best = ns;
+    }
+    std::printf("%-40s %10.2f ns/call\n", name, best);
+    return best;
+}
+
+}  // namespace bench
@@ -0,0 +1,80 @@
+/**
+ * @file bench_background_scheduler.cpp
+ * @brief Per-loop cost of BackgroundScheduler::service() with 10 contexts
+ *
+ * The clock is virtual, so the numbers are the scheduler's own work: the
+ * due check per context, plus the virtual tick() call of the due ones
+ * (their bodies are empty).
+ * - none due: the common loop, between refresh periods
+ * - all due: every context ticks in the same call
+ * - 1 context due: the usual mix, one LED refresh among idle contexts
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "BackgroundScheduler.hpp"
+#include "bench.hpp"
+#include "sim.hpp"
+
+namespace {
+
+using example::BackgroundContext;
+using example::Clock;
+using sim::VirtualClock;
+
+class Counter : public BackgroundContext {
+public:
+    void tick(uint32_t) override { ++ticks; }
+    const char* name() const override { return "counter"; }
+    uint32_t ticks = 0;
+};
+
+constexpr uint32_t CALLS = 2000000;
+constexpr size_t CONTEXTS = 10;
+
+}  // namespace
+
+int main() {
+    VirtualClock clock;
+    std::array<Counter, CONTEXTS> contexts;
+
+    {
+        example::BackgroundScheduler<> scheduler{Clock::from(clock)};
+        for (Counter& c : contexts) scheduler.add(c, 0xFFFFFF);
+        scheduler.begin();
+        scheduler.service(1000000);
+        bench::run("10 contexts, none due", CALLS, [&](uint32_t) { bench::keep(scheduler.service(200)); });
+    }
+
+    {
+        example::BackgroundScheduler<> scheduler{Clock::from(clock)};
+        for (Counter& c : contexts) scheduler.add(c, 1);
+        scheduler.begin();
+        bench::run("10 contexts, all due", CALLS, [&](uint32_t) {
+            ++clock.us;
+            bench::keep(scheduler.service(200));
+        });
+    }
+
+    {
+        example::BackgroundScheduler<> scheduler{Clock::from(clock)};
+        scheduler.add(contexts[0], 1);
+        for (size_t i = 1; i < CONTEXTS; ++i) scheduler.add(contexts[i], 0xFFFFFF);
+        scheduler.begin();
+        scheduler.service(1000000);
+        bench::run("10 contexts, 1 due", CALLS, [&](uint32_t) {
+            ++clock.us;
+            bench::keep(scheduler.service(200));
+        });
+    }
+
+    // Due contexts ran once per call (5 rounds), idle ones only on their first call
+    if (contexts[0].ticks != 2 * 5 * CALLS + 2 || contexts[1].ticks != 5 * CALLS + 2) {
+        std::printf("MISMATCH %u %u\n", contexts[0].ticks, contexts[1].ticks);
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file bench_button_scan.cpp
+ * @brief Button scan cost: constexpr scan plan vs pins resolved at run time
+ *
+ * Three variants over the same simulated GPIO registers (volatile, so every
+ * read happens):
+ * - per pin: one register read + mask per button, as digitalRead() does
+ * - runtime plan: ports and masks resolved once into arrays (the old begin())
+ * - constexpr plan: GpioButtonSource, ports and bits known at compile time
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "GpioButtonSource.hpp"
+#include "bench.hpp"
+
+namespace {
+
+using example::ButtonPin;
+
+volatile uint32_t psr[4] = {0xA5A5A5A5, 0x5A5A5A5A, 0x0F0F0F0F, 0xF0F0F0F0};
+
+struct SimGpio {
+    static void configure(uint8_t, bool) {}
+    template <uint8_t PORT>
+    static uint32_t read() { return psr[PORT - 6]; }
+};
+
+constexpr std::array<ButtonPin, 3> PANEL = {{
+    {.id = 1, .pin = 32, .activeLow = true},
+    {.id = 2, .pin = 35, .activeLow = true},
+    {.id = 3, .pin = 4, .activeLow = true},
+}};
+
+constexpr std::array<ButtonPin, 32> GRID = [] {
+    std::array<ButtonPin, 32> pins{};
+    constexpr uint8_t PIN_LIST[32] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 14, 15, 16,
+                                      17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32};
+    for (uint8_t i = 0; i < 32; ++i) pins[i] = {static_cast<uint8_t>(i + 1), PIN_LIST[i], true};
+    return pins;
+}();
+
+/// Ports and masks resolved at run time, one pointer per port
+template <size_t N>
+struct RuntimePlan {
+    std::array<volatile uint32_t*, N> ports{};
+    std::array<uint8_t, N> portOf{};
+    std::array<uint32_t, N> maskOf{};
+    size_t portCount = 0;
+    uint32_t invert = 0;
+
+    explicit RuntimePlan(const std::array<ButtonPin, N>& pins) {
+        for (size_t i = 0; i < N; ++i) {
+            const auto g = example::teensy41::gpioOf(pins[i].pin);
+            volatile uint32_t* reg = &psr[g.port - 6];
+            size_t port = 0;
+            while (port < portCount && ports[port] != reg) ++port;
+            if (port == portCount) ports[portCount++] = reg;
+            portOf[i] = static_cast<uint8_t>(port);
+            maskOf[i] = 1u << g.bit;
+            if (pins[i].activeLow) invert |= 1u << i;
+        }
+    }
+
+    uint32_t scanPerPin() const {
+        uint32_t raw = 0;
+        for (size_t i = 0; i < N; ++i) {
+            if (*ports[portOf[i]] & maskOf[i]) raw |= 1u << i;
+        }
+        return raw ^ invert;
+    }
+
+    uint32_t scanPerPort() const {
+        std::array<uint32_t, N> levels{};
+        for (size_t port = 0; port < portCount; ++port) levels[port] = *ports[port];
+        uint32_t raw = 0;
+        for (size_t i = 0; i < N; ++i) {
+            if (levels[portOf[i]] & maskOf[i]) raw |= 1u << i;
+        }
+        return raw ^ invert;
+    }
+};
+
+template <size_t N, const std::array<ButtonPin, N>& PINS>
+void benchPanel(const char* perPin, const char* runtime, const char* compiled) {
+    constexpr uint32_t CALLS = 2000000;
+    RuntimePlan<N> plan{PINS};
+    example::GpioButtonSource<N, PINS, SimGpio> source{5000};
+
+    bench::run(perPin, CALLS, [&](uint32_t) { bench::keep(plan.scanPerPin()); });
+    bench::run(runtime, CALLS, [&](uint32_t) { bench::keep(plan.scanPerPort()); });
+    bench::run(compiled, CALLS, [&](uint32_t) { bench::keep(source.scan()); });
+    // Same result whatever the variant
+    if (plan.scanPerPin() != source.scan() || plan.scanPerPort() != source.scan()) {
+        std::printf("MISMATCH\n");
+        std::exit(1);
+    }
+}
+
+}  // namespace
+
+int main() {
+    benchPanel<PANEL.size(), PANEL>("3 buttons, read per pin", "3 buttons, runtime plan", "3 buttons, constexpr plan");
+    benchPanel<GRID.size(), GRID>("32 buttons, read per pin", "32 buttons, runtime plan", "32 buttons, constexpr plan");
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file bench_controller_snapshot.cpp
+ * @brief Per-tick cost of ControllerSnapshot<1024>: set() calls plus one flush()
+ *
+ * All 1024 controllers are registered. Every call is one tick: a handful of
+ * set() calls, each changing its value, then flush() scans the dirty bitset.
+ * - idle: nothing set, flush() only scans the 32 dirty words
+ * - sparse: 4 controllers spread across the table
+ * - coalesced: the same 4 controllers set 16 times each, sent once
+ * - dense: every other controller (512)
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ControllerSnapshot.hpp"
+#include "bench.hpp"
+
+namespace {
+
+using Snapshot = example::ControllerSnapshot<1024>;
+
+constexpr uint32_t CALLS = 200000;
+
+struct Counter {
+    uint32_t sent = 0;
+    uint32_t sum = 0;
+    void operator()(uint8_t, uint8_t cc, uint8_t value) {
+        ++sent;
+        sum += cc + value;
+    }
+};
+
+/// Set count ids (0, stride, 2 * stride...) repeats times each, then flush
+bool benchTick(const char* name, uint32_t count, uint32_t stride, uint32_t repeats) {
+    Snapshot snapshot;
+    for (uint32_t i = 0; i < 1024; ++i) {
+        snapshot.add(static_cast<uint8_t>(i / 128), static_cast<uint8_t>(i % 128));
+    }
+    Counter out;
+    bench::run(name, CALLS, [&](uint32_t i) {
+        for (uint32_t r = 0; r < repeats; ++r) {
+            // Ends on a value that differs from the previous tick's
+            const uint8_t value = static_cast<uint8_t>((i & 1) ? 127 - r : r + 1);
+            for (uint32_t n = 0; n < count; ++n) snapshot.set(static_cast<Snapshot::Id>(n * stride), value);
+        }
+        bench::keep(snapshot.flush(out));
+    });
+    bench::keep(out.sum);
+    if (out.sent != 5 * CALLS * count) {
+        std::printf("MISMATCH %s: sent %u\n", name, out.sent);
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    bool ok = benchTick("1024 controllers, idle", 0, 1, 1);
+    ok &= benchTick("1024 controllers, 4 sparse sets", 4, 256, 1);
+    ok &= benchTick("1024 controllers, 4 x 16 coalesced sets", 4, 256, 16);
+    ok &= benchTick("1024 controllers, 512 dense sets", 512, 2, 1);
+    return ok ? 0 : EXIT_FAILURE;
+}
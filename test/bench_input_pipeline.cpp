@@ -0,0 +1,113 @@
+/**
+ * @file bench_input_pipeline.cpp
+ * @brief Per-tick cost of InputPipeline: pushes plus dispatch() over mixed input
+ *
+ * The pipeline has the main sketch's sizes and binding set (Button 1 long
+ * press, Button 2 press/release/double tap, coarse and fine encoder turns),
+ * with counting handlers and a counting visitor. One call is one 1 ms tick:
+ * the sources push their events, then dispatch() drains them.
+ * - idle: nothing queued, only the long-press check of held buttons
+ * - light: one button edge, one encoder turn, one pressure update
+ * - busy: 4 button edges, 4 encoder turns, 8 pressure updates
+ *
+ * The modifier benches time one encoder turn per call against the plain
+ * turn binding alone, then with the Button 1 held() binding added, with
+ * Button 1 up (the held binding is skipped) and down (it wins).
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "InputPipeline.hpp"
+#include "bench.hpp"
+
+namespace {
+
+using Pipeline = example::InputPipeline<32, 16>;
+
+constexpr uint32_t CALLS = 1000000;
+constexpr uint32_t TICK_US = 1000;
+
+struct Counters {
+    uint32_t handlers = 0;
+    uint32_t visited = 0;
+    uint32_t pushed = 0;
+    uint32_t processed = 0;
+};
+
+void bindLikeMain(Pipeline& input, Counters& c) {
+    uint32_t* h = &c.handlers;
+    input.onButton(1).longPress().then([h]() { ++*h; });
+    input.onButton(2).press().then([h]() { ++*h; });
+    input.onButton(2).release().then([h]() { ++*h; });
+    input.onButton(2).doubleTap().then([h]() { ++*h; });
+    input.onEncoder(1).turn().then([h](const example::InputEvent& e) { *h += static_cast<uint8_t>(e.delta); });
+    input.onButton(1).held().onEncoder(1).turn().then([h](const example::InputEvent& e) { *h += static_cast<uint8_t>(e.delta); });
+}
+
+/// Push one tick's events (edges on Button 2 then pads 11..13, turns, pad pressures) and dispatch them
+void tick(Pipeline& input, Counters& c, uint32_t i, uint32_t buttons, uint32_t turns, uint32_t pressures) {
+    const uint32_t nowUs = i * TICK_US;
+    for (uint32_t b = 0; b < buttons; ++b) {
+        // Every button alternates press and release from one tick to the next
+        const uint8_t id = b == 0 ? 2 : static_cast<uint8_t>(10 + b);
+        input.pushButton(id, (i & 1) == 0, nowUs);
+    }
+    for (uint32_t t = 0; t < turns; ++t) input.pushEncoder(1, (t & 1) ? -1 : 1, nowUs);
+    for (uint32_t p = 0; p < pressures; ++p) {
+        input.pushPressure(static_cast<uint8_t>(11 + (p & 3)), static_cast<uint8_t>(i + p), nowUs);
+    }
+    c.pushed += buttons + turns + pressures;
+    c.processed += static_cast<uint32_t>(input.dispatch(nowUs, [&c](const example::InputEvent&) { ++c.visited; }));
+}
+
+bool benchTick(const char* name, uint32_t buttons, uint32_t turns, uint32_t pressures) {
+    Pipeline input{{.longPressUs = 500000, .doubleTapUs = 300000}};
+    Counters c;
+    bindLikeMain(input, c);
+    bench::run(name, CALLS, [&](uint32_t i) { tick(input, c, i, buttons, turns, pressures); });
+    bench::keep(c.handlers);
+    // Every pushed event was drained in its own tick
+    if (c.processed != c.pushed || c.visited < c.processed || input.dropped() != 0) {
+        std::printf("MISMATCH %s: pushed %u processed %u visited %u\n", name, c.pushed, c.processed, c.visited);
+        return false;
+    }
+    return true;
+}
+
+/// One turn per call; counts which of the coarse and fine bindings ran
+bool benchTurn(const char* name, bool withModifier, bool held) {
+    Pipeline input;
+    uint32_t coarse = 0, fine = 0;
+    uint32_t* c = &coarse;
+    uint32_t* f = &fine;
+    input.onEncoder(1).turn().then([c]() { ++*c; });
+    if (withModifier) input.onButton(1).held().onEncoder(1).turn().then([f]() { ++*f; });
+    if (held) input.pushButton(1, true, 0);
+    input.dispatch(0);
+    coarse = fine = 0;
+
+    bench::run(name, CALLS, [&](uint32_t i) {
+        input.pushEncoder(1, 1, i);
+        bench::keep(input.dispatch(i));
+    });
+    const uint32_t expected = 5 * CALLS;
+    if ((held ? fine : coarse) != expected || (held ? coarse : fine) != 0) {
+        std::printf("MISMATCH %s: coarse %u fine %u\n", name, coarse, fine);
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    bool ok = benchTick("idle tick", 0, 0, 0);
+    ok &= benchTick("light tick: 1 edge, 1 turn, 1 pressure", 1, 1, 1);
+    ok &= benchTick("busy tick: 4 edges, 4 turns, 8 pressures", 4, 4, 8);
+    ok &= benchTurn("turn, plain binding only", false, false);
+    ok &= benchTurn("turn, modifier bound, not held", true, false);
+    ok &= benchTurn("turn, modifier bound and held", true, true);
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file bench_ladder_classifier.cpp
+ * @brief Ladder throughput: 16-sample averaging plus classify() over seeded noise
+ *
+ * The main sketch's 8-button ladder (10-bit ADC, centers 128 counts apart).
+ * Each call is what one DMA result and one AnalogLadderSource::poll() cost:
+ * a new sample lands in the 16-entry ring (volatile, as DMA writes it), the
+ * ring is averaged and the average classified. The input holds a random key
+ * (or idle) for 64 samples at a time, each sample with +-40 counts of
+ * uniform noise, from a fixed seed: every run sees the same stream.
+ *
+ * Once a hold has filled the ring, every result must be that key.
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "LadderClassifier.hpp"
+#include "bench.hpp"
+
+namespace {
+
+using Ladder = example::LadderClassifier<8>;
+
+constexpr std::array<uint16_t, 8> CENTERS = {0, 128, 256, 384, 512, 640, 768, 896};
+constexpr uint16_t IDLE = 1023;
+constexpr uint16_t HYSTERESIS = 16;
+constexpr size_t SAMPLES = 16;
+constexpr size_t HOLD = 64;
+constexpr int NOISE = 40;
+constexpr uint32_t CALLS = 4000000;
+
+/// xorshift32: small, seeded, the same on every host
+struct Rng {
+    uint32_t state;
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+struct Stream {
+    std::vector<uint16_t> samples;
+    std::vector<uint8_t> keys;  ///< Key held at each sample (Ladder::NONE = idle)
+};
+
+Stream makeStream(size_t holds) {
+    Rng rng{0x2545F491u};
+    Stream s;
+    for (size_t h = 0; h < holds; ++h) {
+        const uint32_t pick = rng.next() % 9;
+        const uint8_t key = pick == 8 ? Ladder::NONE : static_cast<uint8_t>(pick);
+        const int center = key == Ladder::NONE ? IDLE : CENTERS[key];
+        for (size_t n = 0; n < HOLD; ++n) {
+            const int noise = static_cast<int>(rng.next() % (2 * NOISE + 1)) - NOISE;
+            const int sample = center + noise;
+            s.samples.push_back(static_cast<uint16_t>(sample < 0 ? 0 : sample > 1023 ? 1023 : sample));
+            s.keys.push_back(key);
+        }
+    }
+    return s;
+}
+
+volatile uint16_t ring[SAMPLES];
+
+/// One DMA result, then poll()'s averaging and classification
+uint8_t step(Ladder& ladder, uint16_t sample, uint32_t i) {
+    ring[i % SAMPLES] = sample;
+    uint32_t sum = 0;
+    for (size_t n = 0; n < SAMPLES; ++n) sum += ring[n];
+    return ladder.classify(static_cast<uint16_t>(sum / SAMPLES));
+}
+
+}  // namespace
+
+int main() {
+    const Stream stream = makeStream(1024);
+    const uint32_t size = static_cast<uint32_t>(stream.samples.size());
+
+    Ladder ladder{CENTERS, IDLE, HYSTERESIS};
+    for (volatile uint16_t& s : ring) s = IDLE;
+    uint32_t wrong = 0;
+    const double ns = bench::run("ladder: 16-sample average + classify", CALLS, [&](uint32_t i) {
+        const uint32_t at = i % size;
+        const uint8_t key = step(ladder, stream.samples[at], i);
+        if (at % HOLD >= SAMPLES && key != stream.keys[at]) ++wrong;
+    });
+    std::printf("%-40s %10.1f M samples/s\n", "ladder throughput", 1e3 / ns);
+
+    if (wrong != 0) {
+        std::printf("MISMATCH: %u samples classified as the wrong key\n", wrong);
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file bench_midi_actions.cpp
+ * @brief Declarative ActionTable::run() vs the same mappings as InputCallback lambdas
+ *
+ * Both variants get the main sketch's 15 mappings and the same event stream
+ * (press, pressure for the FSR pads, release, across every mapped button),
+ * one event pushed and dispatched per call:
+ * - table: no bindings, the dispatch visitor runs the action table
+ * - lambdas: one binding per press/release/pressure, each capturing its
+ *   message, as the mappings were written before the table
+ * The messages produced must be the same, in the same order.
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "InputPipeline.hpp"
+#include "MidiActions.hpp"
+#include "bench.hpp"
+
+namespace {
+
+using example::InputEvent;
+using example::MidiAction;
+using example::MidiMessage;
+using Pipeline = example::InputPipeline<32, 32>;
+
+constexpr uint8_t CH = 0;
+constexpr std::array<MidiAction, 15> ACTIONS = {{
+    example::momentaryCC(1, CH, 20),
+    example::sendCC(3, CH, 22, 64),
+    example::sendNote(11, CH, 60, 100),
+    example::sendNote(12, CH, 61, 100),
+    example::sendNote(13, CH, 62, 100),
+    example::sendNote(14, CH, 63, 100),
+    example::sendNote(15, CH, 64, 100),
+    example::sendNote(16, CH, 65, 100),
+    example::sendNote(17, CH, 66, 100),
+    example::sendNote(18, CH, 67, 100),
+    example::momentaryCC(21, CH, 23),
+    example::momentaryCC(22, CH, 24),
+    example::sendNote(25, CH, 72, 100),
+    example::aftertouch(25, CH, 72),
+    example::pressureCC(26, CH, 25),
+}};
+
+constexpr uint32_t CALLS = 1000000;
+
+/// Order-sensitive digest of the messages sent
+struct Sink {
+    uint32_t count = 0;
+    uint32_t hash = 2166136261u;
+    void operator()(const MidiMessage& m) {
+        ++count;
+        for (uint8_t b : {uint8_t(m.kind), m.channel, m.number, m.value}) hash = (hash ^ b) * 16777619u;
+    }
+};
+
+std::vector<InputEvent> makeStream() {
+    constexpr uint8_t BUTTONS[] = {1, 3, 11, 12, 13, 14, 15, 16, 17, 18, 21, 22, 25, 26};
+    std::vector<InputEvent> stream;
+    auto add = [&](uint8_t id, example::InputType type, uint8_t delta) {
+        stream.push_back({0, example::InputSource::BUTTON, type, id, static_cast<int8_t>(delta)});
+    };
+    for (uint8_t id : BUTTONS) {
+        add(id, example::InputType::PRESS, 0);
+        if (id >= 25) {
+            for (uint8_t p = 20; p <= 100; p += 40) add(id, example::InputType::PRESSURE, p);
+        }
+        add(id, example::InputType::RELEASE, 0);
+    }
+    return stream;
+}
+
+/// The mapping written by hand: one lambda per message, constants captured
+void bindLambdas(Pipeline& input, Sink* s) {
+    auto cc = [](uint8_t number, uint8_t value) { return MidiMessage{MidiMessage::Kind::CC, CH, number, value}; };
+    auto on = [](uint8_t note) { return MidiMessage{MidiMessage::Kind::NOTE_ON, CH, note, 100}; };
+    auto off = [](uint8_t note) { return MidiMessage{MidiMessage::Kind::NOTE_OFF, CH, note, 0}; };
+    auto send = [s](MidiMessage m) { return [s, m]() { (*s)(m); }; };
+
+    input.onButton(1).press().then(send(cc(20, 127)));
+    input.onButton(1).release().then(send(cc(20, 0)));
+    input.onButton(3).press().then(send(cc(22, 64)));
+    for (uint8_t i = 0; i < 8; ++i) {
+        input.onButton(static_cast<uint8_t>(11 + i)).press().then(send(on(static_cast<uint8_t>(60 + i))));
+        input.onButton(static_cast<uint8_t>(11 + i)).release().then(send(off(static_cast<uint8_t>(60 + i))));
+    }
+    input.onButton(21).press().then(send(cc(23, 127)));
+    input.onButton(21).release().then(send(cc(23, 0)));
+    input.onButton(22).press().then(send(cc(24, 127)));
+    input.onButton(22).release().then(send(cc(24, 0)));
+    input.onButton(25).press().then(send(on(72)));
+    input.onButton(25).release().then(send(off(72)));
+    input.onButton(25).pressure().then([s](const InputEvent& e) {
+        (*s)(MidiMessage{MidiMessage::Kind::POLY_PRESSURE, CH, 72, static_cast<uint8_t>(e.delta)});
+    });
+    input.onButton(26).pressure().then([s](const InputEvent& e) {
+        (*s)(MidiMessage{MidiMessage::Kind::CC, CH, 25, static_cast<uint8_t>(e.delta)});
+    });
+}
+
+/// Feed stream[i], spaced so that no long press or double tap forms
+void feed(Pipeline& input, const std::vector<InputEvent>& stream, uint32_t i) {
+    const InputEvent& e = stream[i % stream.size()];
+    const uint32_t nowUs = i * 1000;
+    if (e.type == example::InputType::PRESSURE) {
+        input.pushPressure(e.id, static_cast<uint8_t>(e.delta), nowUs);
+    } else {
+        input.pushButton(e.id, e.type == example::InputType::PRESS, nowUs);
+    }
+}
+
+}  // namespace
+
+int main() {
+    const std::vector<InputEvent> stream = makeStream();
+
+    Sink tableSink;
+    {
+        Pipeline input{{.longPressUs = 0xFFFFFFF, .doubleTapUs = 0}};
+        example::ActionTable<ACTIONS.size()> actions{ACTIONS};
+        bench::run("action table, 15 mappings", CALLS, [&](uint32_t i) {
+            feed(input, stream, i);
+            input.dispatch(i * 1000, [&](const InputEvent& e) { actions.run(e, tableSink); });
+        });
+    }
+
+    Sink lambdaSink;
+    {
+        Pipeline input{{.longPressUs = 0xFFFFFFF, .doubleTapUs = 0}};
+        bindLambdas(input, &lambdaSink);
+        bench::run("lambda bindings, 15 mappings", CALLS, [&](uint32_t i) {
+            feed(input, stream, i);
+            input.dispatch(i * 1000);
+        });
+    }
+
+    bench::keep(tableSink.hash);
+    bench::keep(lambdaSink.hash);
+    if (tableSink.count != lambdaSink.count || tableSink.hash != lambdaSink.hash || tableSink.count == 0) {
+        std::printf("MISMATCH %u %u\n", tableSink.count, lambdaSink.count);
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file bench_midi_packets.cpp
+ * @brief MIDI send cost: message + flush per message vs packets committed per tick
+ *
+ * Both variants send the same resync burst (CCs and notes) to a simulated
+ * endpoint shaped like the Teensy core's: packets fill a 512-byte transmit
+ * buffer, a flush hands the filled part to the "controller" (a copy into
+ * volatile memory stands in for the transfer setup).
+ * - per message: a MidiMessage converted and flushed on its own, as
+ *   usbMIDI.sendControlChange() + send_now() does
+ * - per tick: MidiPacketWriter, packets built in a register, one commit for
+ *   the tick's messages
+ *
+ * Timings are per tick of 8 messages. It also prints the USB transfers per
+ * 1000 messages, which is what the host actually sees: the host has no
+ * transfer cost, the Teensy pays one per flush.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "MidiActions.hpp"
+#include "MidiPacketWriter.hpp"
+#include "bench.hpp"
+
+namespace {
+
+using example::MidiMessage;
+
+/// Transmit buffer + transfer counter, like usb_midi_write_packed()/usb_midi_flush_output()
+struct SimEndpoint {
+    static constexpr size_t PACKETS = 512 / 4;
+
+    std::array<uint32_t, PACKETS> buffer{};
+    volatile uint32_t wire[PACKETS];
+    size_t fill = 0;
+    uint32_t transfers = 0;
+    uint32_t checksum = 0;
+
+    void write(uint32_t packet) {
+        buffer[fill++] = packet;
+        if (fill == PACKETS) flush();
+    }
+
+    void flush() {
+        if (fill == 0) return;
+        for (size_t i = 0; i < fill; ++i) {
+            wire[i] = buffer[i];
+            checksum = checksum * 31 + buffer[i];
+        }
+        fill = 0;
+        ++transfers;
+    }
+};
+
+/// Writer port over a shared endpoint
+struct EndpointPort {
+    SimEndpoint* endpoint;
+    void write(uint32_t packet) { endpoint->write(packet); }
+    void flush() { endpoint->flush(); }
+};
+
+/// The generic path: a message object, converted on every send
+uint32_t toPacket(const MidiMessage& m) {
+    switch (m.kind) {
+        case MidiMessage::Kind::CC: return example::packet::cc(m.channel, m.number, m.value);
+        case MidiMessage::Kind::NOTE_ON: return example::packet::noteOn(m.channel, m.number, m.value);
+        case MidiMessage::Kind::NOTE_OFF: return example::packet::noteOff(m.channel, m.number, m.value);
+        case MidiMessage::Kind::POLY_PRESSURE: return example::packet::polyPressure(m.channel, m.number, m.value);
+    }
+    return 0;
+}
+
+constexpr uint32_t TICKS = 200000;
+constexpr uint32_t PER_TICK = 8;  // A resync batch plus a few notes
+
+MidiMessage messageFor(uint32_t tick, uint32_t i) {
+    const auto value = static_cast<uint8_t>((tick + i) & 0x7F);
+    if (i & 1) return {MidiMessage::Kind::NOTE_ON, 0, static_cast<uint8_t>(60 + i), value};
+    return {MidiMessage::Kind::CC, 0, static_cast<uint8_t>(20 + i), value};
+}
+
+uint32_t packetFor(uint32_t tick, uint32_t i) {
+    const auto value = static_cast<uint8_t>((tick + i) & 0x7F);
+    if (i & 1) return example::packet::noteOn(0, static_cast<uint8_t>(60 + i), value);
+    return example::packet::cc(0, static_cast<uint8_t>(20 + i), value);
+}
+
+void report(const char* name, const SimEndpoint& endpoint, uint32_t messages) {
+    std::printf("%-40s %10.1f transfers/1000 msgs\n", name, endpoint.transfers * 1000.0 / messages);
+}
+
+}  // namespace
+
+int main() {
+    SimEndpoint perMessage;
+    bench::run("8 msgs, convert + flush each", TICKS, [&](uint32_t tick) {
+        for (uint32_t i = 0; i < PER_TICK; ++i) {
+            perMessage.write(toPacket(messageFor(tick, i)));
+            perMessage.flush();
+        }
+    });
+
+    SimEndpoint perTick;
+    example::MidiPacketWriter<EndpointPort> writer{EndpointPort{&perTick}};
+    bench::run("8 msgs, packets + one commit", TICKS, [&](uint32_t tick) {
+        for (uint32_t i = 0; i < PER_TICK; ++i) writer.write(packetFor(tick, i));
+        writer.commit();
+    });
+
+    const uint32_t messages = 5 * TICKS * PER_TICK;
+    report("per message", perMessage, messages);
+    report("per tick", perTick, messages);
+
+    // Same bytes on the wire whatever the variant
+    SimEndpoint a;
+    SimEndpoint b;
+    example::MidiPacketWriter<EndpointPort> check{EndpointPort{&b}};
+    for (uint32_t tick = 0; tick < 100; ++tick) {
+        for (uint32_t i = 0; i < PER_TICK; ++i) {
+            a.write(toPacket(messageFor(tick, i)));
+            check.write(packetFor(tick, i));
+        }
+        a.flush();
+        check.commit();
+    }
+    if (a.checksum != b.checksum || a.transfers != 100 || b.transfers != 100) {
+        std::printf("MISMATCH\n");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file bench_touch_detector.cpp
+ * @brief Touch pad cost per tick: TouchDetector::update() plus the round-robin step
+ *
+ * TouchButtonSource::poll() without measure() (the charge-time loop needs
+ * the pins; it is capped by timeoutCycles on the device): one pad per tick,
+ * its detector updated, the touch bitmask debounced, edges pushed into an
+ * InputPipeline and drained. Readings come from synthetic traces, +-20
+ * noise around a 1000 baseline, with the main sketch's 5 ms debounce and
+ * 100 us ticks.
+ * - untouched: noise only, the common tick
+ * - tapping: every pad alternately touched (+600) and released for 40 of
+ *   its readings, so the slow paths (touch decisions, debounced edges,
+ *   pushes) keep running: the worst case per tick
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Debouncer.hpp"
+#include "InputPipeline.hpp"
+#include "TouchDetector.hpp"
+#include "bench.hpp"
+
+namespace {
+
+using Pipeline = example::InputPipeline<32, 8>;
+
+constexpr uint32_t TICK_US = 100;
+constexpr uint32_t DEBOUNCE_US = 5000;
+constexpr uint32_t CALLS = 2000000;
+constexpr size_t TRACE = 4096;
+
+/// Readings for one pad; period 0 = never touched
+std::vector<uint16_t> makeTrace(uint32_t seed, size_t period) {
+    std::vector<uint16_t> trace(TRACE);
+    for (size_t n = 0; n < TRACE; ++n) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        const bool touched = period && (n / period) % 2 == 1;
+        trace[n] = static_cast<uint16_t>((touched ? 1600 : 1000) + int(seed % 41) - 20);
+    }
+    return trace;
+}
+
+/// TouchButtonSource::poll() with the reading given
+template <size_t N>
+struct RoundRobin {
+    std::array<example::TouchDetector, N> detectors{};
+    uint32_t touched = 0;
+    size_t next = 0;
+    example::Debouncer<N> debouncer{DEBOUNCE_US};
+    uint32_t edges = 0;
+
+    void poll(Pipeline& pipeline, const std::array<std::vector<uint16_t>, N>& traces, uint32_t tick) {
+        const size_t i = next;
+        next = (next + 1) % N;
+        const uint32_t nowUs = tick * TICK_US;
+
+        const uint16_t reading = traces[i][(tick / N) % TRACE];
+        if (detectors[i].update(reading, nowUs)) touched |= 1u << i;
+        else touched &= ~(1u << i);
+
+        const uint32_t changed = debouncer.update(touched, nowUs);
+        for (uint32_t bits = changed; bits; bits &= bits - 1) {
+            const uint32_t b = __builtin_ctz(bits);
+            pipeline.pushButton(static_cast<uint8_t>(21 + b), (debouncer.state() >> b) & 1u, nowUs);
+            ++edges;
+        }
+    }
+};
+
+template <size_t N>
+bool benchPads(const char* name, size_t period) {
+    std::array<std::vector<uint16_t>, N> traces;
+    for (size_t p = 0; p < N; ++p) traces[p] = makeTrace(0x9E3779B9u + static_cast<uint32_t>(p), period);
+
+    Pipeline input;
+    RoundRobin<N> pads;
+    uint32_t tick = 0;
+    bench::run(name, CALLS, [&](uint32_t) {
+        pads.poll(input, traces, tick++);
+        input.dispatch(tick * TICK_US);
+    });
+
+    // Untouched: no edge at all; tapping: one per touch and per release
+    const bool ok = period ? pads.edges > 0 && input.dropped() == 0 : pads.edges == 0;
+    if (!ok) std::printf("MISMATCH %s: %u edges\n", name, pads.edges);
+    return ok;
+}
+
+}  // namespace
+
+int main() {
+    bool ok = benchPads<2>("2 pads, untouched", 0);
+    ok &= benchPads<2>("2 pads, tapping", 40);
+    ok &= benchPads<8>("8 pads, untouched", 0);
+    ok &= benchPads<8>("8 pads, tapping", 40);
+    return ok ? 0 : EXIT_FAILURE;
+}
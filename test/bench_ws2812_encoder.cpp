@@ -0,0 +1,63 @@
+/**
+ * @file bench_ws2812_encoder.cpp
+ * @brief Ws2812Encoder::encode(): full frame vs one changed pixel
+ *
+ * Each call changes the colors, then encodes, for the main sketch's 8
+ * pixels and for a 64-pixel strip:
+ * - full frame: every pixel changed (as after invalidate())
+ * - 1 pixel, first: only pixel 0 re-encoded, 8 bytes to send
+ * - 1 pixel, last: only the last pixel re-encoded, the whole stream sent
+ * The stream is decoded afterwards and must hold every pixel's color.
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Ws2812Encoder.hpp"
+#include "bench.hpp"
+
+namespace {
+
+constexpr uint32_t CALLS = 500000;
+
+/// Back from 8 characters to 0xRRGGBB
+uint32_t decodePixel(const uint8_t* chars) {
+    uint32_t grb = 0;
+    for (size_t c = 0; c < 8; ++c) {
+        for (uint8_t mask : {uint8_t(0x01), uint8_t(0x08), uint8_t(0x40)}) grb = (grb << 1) | !(chars[c] & mask);
+    }
+    return ((grb & 0xFF0000) >> 8) | ((grb & 0x00FF00) << 8) | (grb & 0x0000FF);
+}
+
+/// Pixels first..first+count-1 change on every call
+template <size_t N>
+bool benchFrame(const char* name, size_t first, size_t count) {
+    static uint8_t stream[example::Ws2812Encoder<N>::BYTES];
+    example::Ws2812Encoder<N> pixels{stream};
+    pixels.encode();
+    size_t bytes = 0;
+    bench::run(name, CALLS, [&](uint32_t i) {
+        for (size_t p = first; p < first + count; ++p) pixels.set(p, (i * 0x010203u + p) & 0xFFFFFF);
+        bytes = pixels.encode();
+        bench::keep(bytes);
+    });
+
+    bool ok = bytes == (first + count) * example::Ws2812Encoder<N>::BYTES_PER_PIXEL;
+    for (size_t p = 0; p < N; ++p) ok = ok && decodePixel(&stream[p * 8]) == pixels.get(p);
+    if (!ok) std::printf("MISMATCH %s: %zu bytes\n", name, bytes);
+    return ok;
+}
+
+}  // namespace
+
+int main() {
+    bool ok = benchFrame<8>("8 pixels, full frame", 0, 8);
+    ok &= benchFrame<8>("8 pixels, 1 changed (first)", 0, 1);
+    ok &= benchFrame<8>("8 pixels, 1 changed (last)", 7, 1);
+    ok &= benchFrame<64>("64 pixels, full frame", 0, 64);
+    ok &= benchFrame<64>("64 pixels, 1 changed (first)", 0, 1);
+    ok &= benchFrame<64>("64 pixels, 1 changed (last)", 63, 1);
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * @file check.hpp
+ * @brief Minimal assertions for the host tests
+ *
+ * A failed CHECK prints its location and the test keeps going; main()
+ * returns check::result(), which ctest reads as pass/fail.
+ */
+
+#include <cstdio>
+
+namespace check {
+
+inline int failures = 0;
+
+inline int result(const char* suite) {
+    if (failures == 0) std::printf("%s: ok\n", suite);
+    else std::printf("%s: %d failure(s)\n", suite, failures);
+    return failures == 0 ? 0 : 1;
+}
+
+}  // namespace check
+
+#define CHECK(cond)                                                                  \
+    do {                                                                             \
+        if (!(cond)) {                                                               \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);    \
+            ++check::failures;                                                       \
+        }                                                                            \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                               \
+    do {                                                                             \
+        const auto va_ = (a);                                                        \
+        const auto vb_ = (b);                                                        \
+        if (!(va_ == vb_)) {                                                         \
+            std::printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__,  \
+                        __LINE__, #a, #b, static_cast<long long>(va_),               \
+                        static_cast<long long>(vb_));                                \
+            ++check::failures;                                                       \
+        }                                                                            \
+    } while (0)
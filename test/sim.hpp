@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * @file sim.hpp
+ * @brief Simulated time for the host tests and benchmarks
+ *
+ * - VirtualClock: a clock the test advances by hand; pass it to code that
+ *   takes an example::Clock with Clock::from(clock)
+ * - Feeder: drives anything with update(reading, nowUs), one reading per
+ *   TICK_US, as a source's poll() would
+ */
+
+#include <cstdint>
+#include <utility>
+
+namespace sim {
+
+constexpr uint32_t TICK_US = 1000;
+
+struct VirtualClock {
+    uint32_t us = 0;
+    uint32_t nowUs() const { return us; }
+};
+
+/// Feeds `count` readings, one per tick; returns the last update() result
+template <typename Filter>
+struct Feeder {
+    using Result = decltype(std::declval<Filter&>().update(uint16_t{}, uint32_t{}));
+
+    Filter& filter;
+    uint32_t nowUs = 0;
+
+    Result feed(uint16_t reading, int count = 1) {
+        Result out{};
+        for (int i = 0; i < count; ++i) {
+            out = filter.update(reading, nowUs);
+            nowUs += TICK_US;
+        }
+        return out;
+    }
+};
+
+}  // namespace sim
@@ -0,0 +1,148 @@
+/**
+ * @file test_background_scheduler.cpp
+ * @brief BackgroundScheduler on a virtual clock: periods, budget, round-robin, late ticks
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "BackgroundScheduler.hpp"
+#include "check.hpp"
+#include "sim.hpp"
+
+namespace {
+
+using example::BackgroundContext;
+using example::Clock;
+using sim::VirtualClock;
+
+/// Records its ticks; each tick costs costUs of virtual time
+class Recorder : public BackgroundContext {
+public:
+    Recorder(VirtualClock& clock, uint32_t costUs) : clock_(clock), costUs_(costUs) {}
+
+    void init() override { ++inits; }
+    void tick(uint32_t nowUs) override {
+        ticks.push_back(nowUs);
+        clock_.us += costUs_;
+    }
+    const char* name() const override { return "recorder"; }
+
+    std::vector<uint32_t> ticks;
+    int inits = 0;
+
+private:
+    VirtualClock& clock_;
+    uint32_t costUs_;
+};
+
+void testBeginInitsAndRunsEveryContext() {
+    VirtualClock clock;
+    example::BackgroundScheduler<> scheduler{Clock::from(clock)};
+    Recorder a{clock, 0};
+    Recorder b{clock, 0};
+    CHECK(scheduler.add(a, 100));
+    CHECK(scheduler.add(b, 300));
+    scheduler.begin();
+    CHECK_EQ(a.inits, 1);
+    CHECK_EQ(b.inits, 1);
+    CHECK_EQ(scheduler.service(1000), 2u);
+}
+
+void testEachContextKeepsItsPeriod() {
+    VirtualClock clock;
+    example::BackgroundScheduler<> scheduler{Clock::from(clock)};
+    Recorder fast{clock, 0};
+    Recorder slow{clock, 0};
+    scheduler.add(fast, 125);
+    scheduler.add(slow, 20000);
+    scheduler.begin();
+
+    // 1 s of 25 us loops
+    for (; clock.us < 1000000; clock.us += 25) scheduler.service(200);
+    CHECK_EQ(fast.ticks.size(), 8000u);
+    CHECK_EQ(slow.ticks.size(), 50u);
+    CHECK_EQ(scheduler.late(), 0u);
+    // On the period grid: no drift from the loop rate
+    CHECK_EQ(fast.ticks[7999], 7999u * 125);
+}
+
+void testBudgetDefersTheRestRoundRobin() {
+    VirtualClock clock;
+    example::BackgroundScheduler<> scheduler{Clock::from(clock)};
+    Recorder a{clock, 60};
+    Recorder b{clock, 60};
+    Recorder c{clock, 60};
+    scheduler.add(a, 1000);
+    scheduler.add(b, 1000);
+    scheduler.add(c, 1000);
+    scheduler.begin();
+
+    // 100 us budget: the second tick crosses it, the third waits
+    CHECK_EQ(scheduler.service(100), 2u);
+    CHECK_EQ(a.ticks.size(), 1u);
+    CHECK_EQ(b.ticks.size(), 1u);
+    CHECK_EQ(c.ticks.size(), 0u);
+
+    // The one left over goes first on the next call
+    CHECK_EQ(scheduler.service(50), 1u);
+    CHECK_EQ(c.ticks.size(), 1u);
+    CHECK_EQ(scheduler.service(1000), 0u);
+}
+
+void testLateContextIsRescheduledWithoutBurst() {
+    VirtualClock clock;
+    example::BackgroundScheduler<> scheduler{Clock::from(clock)};
+    Recorder r{clock, 0};
+    scheduler.add(r, 100);
+    scheduler.begin();
+    scheduler.service(1000);
+
+    clock.us = 1050;  // A 1 ms foreground stall
+    CHECK_EQ(scheduler.service(1000), 1u);
+    CHECK_EQ(scheduler.late(), 1u);
+    CHECK_EQ(scheduler.service(1000), 0u);  // No catch-up ticks
+    clock.us = 1149;
+    CHECK_EQ(scheduler.service(1000), 0u);
+    clock.us = 1150;
+    CHECK_EQ(scheduler.service(1000), 1u);
+}
+
+void testTenContextsFitTheDefault() {
+    VirtualClock clock;
+    example::BackgroundScheduler<> scheduler{Clock::from(clock)};
+    std::vector<Recorder> contexts(10, Recorder{clock, 1});
+    for (Recorder& r : contexts) CHECK(scheduler.add(r, 500));
+    scheduler.begin();
+    CHECK_EQ(scheduler.size(), 10u);
+    CHECK_EQ(scheduler.service(1000), 10u);
+
+    example::BackgroundScheduler<2> small{Clock::from(clock)};
+    CHECK(small.add(contexts[0], 100));
+    CHECK(small.add(contexts[1], 100));
+    CHECK(!small.add(contexts[2], 100));
+}
+
+void testClockWrap() {
+    VirtualClock clock;
+    clock.us = 0xFFFFFF00u;
+    example::BackgroundScheduler<> scheduler{Clock::from(clock)};
+    Recorder r{clock, 0};
+    scheduler.add(r, 100);
+    scheduler.begin();
+    for (int i = 0; i < 100; ++i, clock.us += 10) scheduler.service(100);
+    CHECK_EQ(r.ticks.size(), 10u);
+    CHECK_EQ(scheduler.late(), 0u);
+}
+
+}  // namespace
+
+int main() {
+    testBeginInitsAndRunsEveryContext();
+    testEachContextKeepsItsPeriod();
+    testBudgetDefersTheRestRoundRobin();
+    testLateContextIsRescheduledWithoutBurst();
+    testTenContextsFitTheDefault();
+    testClockWrap();
+    return check::result("BackgroundScheduler");
+}
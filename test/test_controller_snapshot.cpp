@@ -0,0 +1,134 @@
+/**
+ * @file test_controller_snapshot.cpp
+ * @brief ControllerSnapshot: change coalescing and a 1,000-controller resync burst
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "ControllerSnapshot.hpp"
+#include "check.hpp"
+
+namespace {
+
+struct Sent {
+    uint8_t channel;
+    uint8_t cc;
+    uint8_t value;
+};
+
+struct Recorder {
+    std::vector<Sent> sent;
+    auto sink() {
+        return [this](uint8_t channel, uint8_t cc, uint8_t value) { sent.push_back({channel, cc, value}); };
+    }
+};
+
+void testFlushSendsEachChangeOnce() {
+    example::ControllerSnapshot<40> snapshot;
+    auto a = snapshot.add(0, 10);
+    auto b = snapshot.add(0, 11, 0, 64);
+    auto c = snapshot.add(1, 12);
+
+    Recorder out;
+    snapshot.set(a, 1);
+    snapshot.set(a, 2);   // Coalesces with the first set
+    snapshot.set(b, 64);  // Unchanged: never sent
+    snapshot.set(c, 7);
+    CHECK_EQ(snapshot.flush(out.sink()), 2u);
+    CHECK_EQ(out.sent.size(), 2u);
+    CHECK_EQ(out.sent[0].cc, 10);
+    CHECK_EQ(out.sent[0].value, 2);
+    CHECK_EQ(out.sent[1].channel, 1);
+    CHECK_EQ(out.sent[1].value, 7);
+
+    CHECK_EQ(snapshot.flush(out.sink()), 0u);
+    CHECK_EQ(snapshot.find(1, 12), c);
+    CHECK_EQ(snapshot.find(2, 12), (example::ControllerSnapshot<40>::INVALID));
+}
+
+void testThousandControllerResync() {
+    constexpr size_t COUNT = 1000;
+    constexpr uint8_t BATCH = 8;
+    constexpr uint32_t INTERVAL_US = 1000;
+    static example::ControllerSnapshot<COUNT> snapshot{{.maxPerBatch = BATCH, .intervalUs = INTERVAL_US}};
+
+    for (size_t i = 0; i < COUNT; ++i) {
+        snapshot.add(static_cast<uint8_t>(i / 128), static_cast<uint8_t>(i % 128),
+                     static_cast<uint8_t>(3 - i % 4), static_cast<uint8_t>(i % 127));
+    }
+    CHECK_EQ(snapshot.size(), COUNT);
+
+    Recorder out;
+    snapshot.requestResync();
+    uint32_t now = 0;
+    uint32_t lastBatchAt = 0;
+    size_t batches = 0;
+    size_t liveTicks = 0;
+    for (int tick = 0; tick < 100000 && snapshot.resyncActive(); ++tick, now += 100) {
+        // Live input every 7th tick: that tick's burst batch must yield
+        if (tick % 7 == 0) {
+            snapshot.set(0, static_cast<uint8_t>((tick / 7 + 1) & 0x7F));  // Always a change
+            Recorder live;
+            CHECK_EQ(snapshot.flush(live.sink()), 1u);
+            const size_t before = out.sent.size();
+            snapshot.service(now, out.sink());
+            CHECK_EQ(out.sent.size(), before);
+            ++liveTicks;
+            continue;
+        }
+
+        const size_t before = out.sent.size();
+        snapshot.service(now, out.sink());
+        const size_t n = out.sent.size() - before;
+        CHECK(n <= BATCH);
+        if (n > 0) {
+            if (batches > 0) CHECK(now - lastBatchAt >= INTERVAL_US);
+            lastBatchAt = now;
+            ++batches;
+        }
+    }
+
+    CHECK(!snapshot.resyncActive());
+    CHECK(liveTicks > 0);
+    CHECK_EQ(out.sent.size(), COUNT);
+    CHECK_EQ(batches, (COUNT + BATCH - 1) / BATCH);
+
+    // Every controller exactly once, priority 0 first, stable within a priority
+    std::vector<bool> seen(COUNT, false);
+    int lastPriority = -1;
+    int lastIndex = -1;
+    for (const Sent& s : out.sent) {
+        const size_t index = s.channel * 128u + s.cc;
+        CHECK(index < COUNT);
+        CHECK(!seen[index]);
+        seen[index] = true;
+        const int priority = 3 - static_cast<int>(index % 4);
+        CHECK(priority >= lastPriority);
+        if (priority == lastPriority) CHECK(static_cast<int>(index) > lastIndex);
+        lastPriority = priority;
+        lastIndex = static_cast<int>(index);
+    }
+}
+
+void testResyncRestartsFromTheTop() {
+    example::ControllerSnapshot<8> snapshot{{.maxPerBatch = 2, .intervalUs = 0}};
+    for (uint8_t i = 0; i < 6; ++i) snapshot.add(0, i);
+
+    Recorder out;
+    snapshot.requestResync();
+    snapshot.service(0, out.sink());
+    snapshot.requestResync();  // E.g. the host re-enumerated mid-burst
+    for (uint32_t t = 1; snapshot.resyncActive(); ++t) snapshot.service(t, out.sink());
+    CHECK_EQ(out.sent.size(), 2u + 6u);
+    CHECK_EQ(out.sent[2].cc, 0);
+}
+
+}  // namespace
+
+int main() {
+    testFlushSendsEachChangeOnce();
+    testThousandControllerResync();
+    testResyncRestartsFromTheTop();
+    return check::result("controller_snapshot");
+}
@@ -0,0 +1,141 @@
+/**
+ * @file test_cpu_accounting.cpp
+ * @brief CpuAccounting: per-tick budgets, window load, separate accounts stay apart
+ *
+ * On the host the trace clock counts nanoseconds: 1000 cycles per us.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "CpuAccounting.hpp"
+#include "check.hpp"
+
+namespace {
+
+using Cpu = example::CpuAccounting<4>;
+constexpr uint32_t CYCLES_PER_US = 1000;
+
+void testBudgetIsPerTick() {
+    Cpu cpu;
+    constexpr Cpu::Id id = 0;
+    CHECK_EQ(cpu.add("main.handlers", 500), id);
+    CHECK_EQ(cpu.account(id).budgetCycles, 500 * CYCLES_PER_US);
+
+    cpu.charge(id, 300 * CYCLES_PER_US);
+    CHECK(!cpu.overBudget(id));
+    cpu.charge(id, 300 * CYCLES_PER_US);
+    CHECK(cpu.overBudget(id));
+
+    cpu.endTick(100);
+    CHECK(!cpu.overBudget(id));
+    CHECK_EQ(cpu.account(id).overBudgetTicks, 1u);
+    CHECK_EQ(cpu.overBudgetTicks(), 1u);
+}
+
+void testUnlimitedAccountNeverOverBudget() {
+    Cpu cpu;
+    constexpr Cpu::Id id = 0;
+    CHECK_EQ(cpu.add("main.init"), id);
+    cpu.charge(id, 0xFFFFFFF);
+    CHECK(!cpu.overBudget(id));
+    cpu.endTick(0);
+    CHECK_EQ(cpu.overBudgetTicks(), 0u);
+}
+
+void testSlowSourceDoesNotChargeTheHandlers() {
+    // The split in MainContext::update(): scans and handlers charge apart
+    Cpu cpu;
+    constexpr Cpu::Id poll = 0;
+    CHECK_EQ(cpu.add("main.poll", 100), poll);
+    constexpr Cpu::Id handlers = 1;
+    CHECK_EQ(cpu.add("main.handlers", 500), handlers);
+    for (int tick = 0; tick < 10; ++tick) {
+        cpu.charge(poll, 120 * CYCLES_PER_US);  // A stuck touch measurement
+        cpu.charge(handlers, 50 * CYCLES_PER_US);
+        cpu.endTick(static_cast<uint32_t>(tick * 1000));
+    }
+    CHECK_EQ(cpu.account(poll).overBudgetTicks, 10u);
+    CHECK_EQ(cpu.account(handlers).overBudgetTicks, 0u);
+}
+
+void testWindowLoadAndWorstTick() {
+    Cpu cpu{10000};  // 10 ms window
+    constexpr Cpu::Id id = 0;
+    CHECK_EQ(cpu.add("bg.leds"), id);
+
+    // 1 ms ticks, 100 us spent each, one 400 us tick
+    for (uint32_t t = 1000; t <= 10000; t += 1000) {
+        cpu.charge(id, (t == 5000 ? 400 : 100) * CYCLES_PER_US);
+        cpu.endTick(t);
+    }
+    CHECK_EQ(cpu.loadPermille(id), (9 * 100 + 400) * 1000 / 10000);
+    CHECK_EQ(cpu.account(id).maxTickCycles, 400 * CYCLES_PER_US);
+
+    // The next window starts clean
+    for (uint32_t t = 11000; t <= 20000; t += 1000) {
+        cpu.charge(id, 50 * CYCLES_PER_US);
+        cpu.endTick(t);
+    }
+    CHECK_EQ(cpu.loadPermille(id), 50);
+    CHECK_EQ(cpu.account(id).maxTickCycles, 50 * CYCLES_PER_US);
+}
+
+void testAccountLimitAndInvalidIds() {
+    Cpu cpu;
+    for (int i = 0; i < 4; ++i) CHECK(cpu.add("a") != Cpu::INVALID);
+    CHECK_EQ(cpu.add("overflow"), Cpu::INVALID);
+    CHECK_EQ(cpu.size(), 4u);
+
+    // Charging or asking for INVALID is a no-op, not a crash
+    cpu.charge(Cpu::INVALID, 1000);
+    CHECK(!cpu.overBudget(Cpu::INVALID));
+    { auto scope = cpu.measure(Cpu::INVALID); }
+}
+
+void testScopeChargesElapsedTime() {
+    Cpu cpu;
+    constexpr Cpu::Id id = 0;
+    CHECK_EQ(cpu.add("main.update"), id);
+    {
+        auto scope = cpu.measure(id);
+        const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(200);
+        while (std::chrono::steady_clock::now() < until) {}
+    }
+    CHECK(cpu.account(id).tickCycles >= 200 * CYCLES_PER_US);
+}
+
+struct StringOut {
+    std::string text;
+    void write(const char* data, size_t size) { text.append(data, size); }
+};
+
+void testPrintOneLinePerAccount() {
+    Cpu cpu{1000};
+    constexpr Cpu::Id poll = 0;
+    CHECK_EQ(cpu.add("main.poll", 100), poll);
+    cpu.add("main.handlers", 500);
+    cpu.charge(poll, 250 * CYCLES_PER_US);
+    cpu.endTick(1000);
+
+    StringOut out;
+    cpu.print(out);
+    CHECK(out.text.find("main.poll       25.0%  max    250 us  budget    100 us  over 1\n") == 0);
+    CHECK(out.text.find("main.handlers") != std::string::npos);
+    CHECK_EQ(std::count(out.text.begin(), out.text.end(), '\n'), 2);
+}
+
+}  // namespace
+
+int main() {
+    testBudgetIsPerTick();
+    testUnlimitedAccountNeverOverBudget();
+    testSlowSourceDoesNotChargeTheHandlers();
+    testWindowLoadAndWorstTick();
+    testAccountLimitAndInvalidIds();
+    testScopeChargesElapsedTime();
+    testPrintOneLinePerAccount();
+    return check::result("CpuAccounting");
+}
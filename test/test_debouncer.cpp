@@ -0,0 +1,63 @@
+/**
+ * @file test_debouncer.cpp
+ * @brief Debouncer: settle window, bounce rejection, independent inputs
+ */
+
+#include <cstdint>
+
+#include "Debouncer.hpp"
+#include "check.hpp"
+
+namespace {
+
+void testChangeAcceptedAfterWindow() {
+    example::Debouncer<4> d{5000};
+    CHECK_EQ(d.update(0b0001, 0), 0u);
+    CHECK_EQ(d.update(0b0001, 4999), 0u);
+    CHECK_EQ(d.update(0b0001, 5000), 0b0001u);
+    CHECK_EQ(d.state(), 0b0001u);
+    CHECK_EQ(d.update(0b0001, 9000), 0u);  // Reported once
+}
+
+void testBounceRestartsTheWindow() {
+    example::Debouncer<4> d{5000};
+    uint32_t t = 0;
+    for (int i = 0; i < 11; ++i, t += 1000) CHECK_EQ(d.update(i % 2 ? 0b10u : 0u, t), 0u);
+    d.update(0b10, t);  // Settles from here
+    CHECK_EQ(d.update(0b10, t + 4000), 0u);
+    CHECK_EQ(d.update(0b10, t + 5000), 0b10u);
+
+    // A glitch shorter than the window never shows
+    CHECK_EQ(d.update(0b00, t + 6000), 0u);
+    CHECK_EQ(d.update(0b10, t + 7000), 0u);
+    CHECK_EQ(d.update(0b10, t + 20000), 0u);
+    CHECK_EQ(d.state(), 0b10u);
+}
+
+void testInputsSettleIndependently() {
+    example::Debouncer<32> d{1000};
+    d.update(0x80000001u, 0);
+    d.update(0x80000003u, 500);
+    CHECK_EQ(d.update(0x80000003u, 1000), 0x80000001u);
+    CHECK_EQ(d.update(0x80000003u, 1500), 0x00000002u);
+    CHECK_EQ(d.state(), 0x80000003u);
+    CHECK_EQ(d.update(0x00000003u, 1600), 0u);
+    CHECK_EQ(d.update(0x00000003u, 2600), 0x80000000u);
+    CHECK_EQ(d.state(), 0x00000003u);
+}
+
+void testClockWrap() {
+    example::Debouncer<1> d{5000};
+    d.update(1, 0xFFFFF000u);
+    CHECK_EQ(d.update(1, 0xFFFFF000u + 5000), 1u);  // Wrapped past 0
+}
+
+}  // namespace
+
+int main() {
+    testChangeAcceptedAfterWindow();
+    testBounceRestartsTheWindow();
+    testInputsSettleIndependently();
+    testClockWrap();
+    return check::result("debouncer");
+}
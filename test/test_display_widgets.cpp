@@ -0,0 +1,168 @@
+/**
+ * @file test_display_widgets.cpp
+ * @brief Widgets rendered into a RAM framebuffer: pixels, dirty rectangles, diffs
+ *
+ * The display driver pushes only the dirty rectangle and diffs it against
+ * the previous frame. Here the previous frame is kept next to the canvas:
+ * every pixel that changed must lie inside the dirty rectangle, and an idle
+ * frame must produce no rectangle at all.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "DisplayWidgets.hpp"
+#include "check.hpp"
+
+namespace {
+
+using example::Canvas;
+using example::IndicatorWidget;
+using example::ProgressWidget;
+using example::Rect;
+namespace color = example::color;
+
+constexpr int16_t W = 64;
+constexpr int16_t H = 32;
+
+struct Screen {
+    std::vector<uint16_t> pixels = std::vector<uint16_t>(W * H, color::BLACK);
+    std::vector<uint16_t> shown = pixels;  ///< What the panel displays
+    Canvas canvas{pixels.data(), W, H};
+
+    uint16_t at(int x, int y) const { return pixels[y * W + x]; }
+
+    /// Push like the driver: return the changed pixel count, check it is all inside dirty
+    uint32_t push() {
+        const Rect dirty = canvas.takeDirty();
+        uint32_t changed = 0;
+        for (int y = 0; y < H; ++y) {
+            for (int x = 0; x < W; ++x) {
+                const size_t i = y * W + x;
+                if (pixels[i] == shown[i]) continue;
+                ++changed;
+                CHECK(!dirty.empty() && x >= dirty.x0 && x <= dirty.x1 && y >= dirty.y0 && y <= dirty.y1);
+                shown[i] = pixels[i];
+            }
+        }
+        CHECK(changed <= dirty.area());
+        return changed;
+    }
+};
+
+void testIndicatorRedrawsOnlyOnChange() {
+    Screen screen;
+    IndicatorWidget lamp{{4, 4, 13, 13}, color::GREEN, color::GREY};
+
+    lamp.draw(screen.canvas);  // First draw: full widget
+    CHECK_EQ(screen.push(), 100u);
+    CHECK_EQ(screen.at(8, 8), color::GREY);
+    CHECK_EQ(screen.at(4, 4), color::WHITE);
+
+    lamp.set(false);  // Same state: nothing to do
+    lamp.draw(screen.canvas);
+    CHECK(!screen.canvas.dirty());
+
+    lamp.set(true);
+    lamp.draw(screen.canvas);
+    CHECK_EQ(screen.push(), 64u);  // Inside of the frame only
+    CHECK_EQ(screen.at(8, 8), color::GREEN);
+}
+
+void testProgressRepaintsOnlyTheMovedSpan() {
+    Screen screen;
+    ProgressWidget bar{{0, 20, 50, 23}, color::ORANGE, color::GREY};
+
+    bar.draw(screen.canvas);
+    screen.push();
+
+    bar.set(255);
+    bar.draw(screen.canvas);
+    const Rect full = screen.canvas.takeDirty();
+    CHECK_EQ(full.x0, 0);
+    CHECK_EQ(full.x1, 50);
+    for (int x = 0; x <= 50; ++x) CHECK_EQ(screen.at(x, 21), color::ORANGE);
+    screen.shown = screen.pixels;
+
+    bar.set(0);
+    bar.draw(screen.canvas);
+    const Rect back = screen.canvas.takeDirty();
+    CHECK_EQ(back.x0, 0);
+    CHECK_EQ(back.x1, 50);
+    CHECK_EQ(screen.at(25, 21), color::GREY);
+    screen.shown = screen.pixels;
+
+    bar.set(128);
+    bar.draw(screen.canvas);
+    const Rect half = screen.canvas.takeDirty();
+    CHECK_EQ(half.x0, 0);
+    CHECK(half.x1 > 20 && half.x1 < 30);
+}
+
+void testLastValueBeforeDrawWins() {
+    // set(100); set(0) between two draws must end at 0, not at 100
+    Screen screen;
+    ProgressWidget bar{{0, 20, 50, 23}, color::ORANGE, color::GREY};
+    bar.draw(screen.canvas);
+    screen.push();
+
+    bar.set(100);
+    bar.set(0);
+    bar.draw(screen.canvas);
+    CHECK(!screen.canvas.dirty());
+    for (int x = 0; x <= 50; ++x) CHECK_EQ(screen.at(x, 21), color::GREY);
+
+    bar.set(255);
+    bar.draw(screen.canvas);
+    screen.push();
+    bar.set(10);
+    bar.set(255);
+    bar.draw(screen.canvas);
+    CHECK(!screen.canvas.dirty());
+    CHECK_EQ(screen.at(50, 21), color::ORANGE);
+}
+
+void testIdleFramePushesNothing() {
+    Screen screen;
+    IndicatorWidget a{{0, 0, 9, 9}, color::GREEN, color::GREY};
+    IndicatorWidget b{{40, 0, 49, 9}, color::GREEN, color::GREY};
+    a.draw(screen.canvas);
+    b.draw(screen.canvas);
+    screen.push();
+
+    for (int frame = 0; frame < 10; ++frame) {
+        a.draw(screen.canvas);
+        b.draw(screen.canvas);
+        CHECK(!screen.canvas.dirty());
+        CHECK_EQ(screen.push(), 0u);
+    }
+
+    // Two distant changes in one frame: one rectangle covering both
+    a.set(true);
+    b.set(true);
+    a.draw(screen.canvas);
+    b.draw(screen.canvas);
+    CHECK_EQ(screen.push(), 128u);
+}
+
+void testCanvasClipsToBounds() {
+    Screen screen;
+    screen.canvas.fill({-5, -5, 2, 2}, color::WHITE);
+    const Rect d = screen.canvas.takeDirty();
+    CHECK_EQ(d.x0, 0);
+    CHECK_EQ(d.y0, 0);
+    CHECK_EQ(d.area(), 9u);
+    screen.canvas.fill({W, H, W + 4, H + 4}, color::WHITE);
+    CHECK(!screen.canvas.dirty());
+}
+
+}  // namespace
+
+int main() {
+    testIndicatorRedrawsOnlyOnChange();
+    testProgressRepaintsOnlyTheMovedSpan();
+    testLastValueBeforeDrawWins();
+    testIdleFramePushesNothing();
+    testCanvasClipsToBounds();
+    return check::result("display_widgets");
+}
@@ -0,0 +1,140 @@
+/**
+ * @file test_gpio_button_source.cpp
+ * @brief GpioButtonSource against simulated GPIO ports: scan plan, levels, debounced edges
+ */
+
+#include <array>
+#include <cstdint>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "GpioButtonSource.hpp"
+#include "InputPipeline.hpp"
+#include "check.hpp"
+
+namespace {
+
+using example::ButtonPin;
+
+/// GPIO6..9 PSR values, plus a count of register reads
+struct SimGpio {
+    static inline std::array<uint32_t, 4> psr{};
+    static inline uint32_t reads = 0;
+    static inline std::vector<std::pair<uint8_t, bool>> configured;
+
+    static void configure(uint8_t pin, bool activeLow) { configured.push_back({pin, activeLow}); }
+
+    template <uint8_t PORT>
+    static uint32_t read() {
+        static_assert(PORT >= 6 && PORT <= 9, "Fast GPIO ports are 6..9");
+        ++reads;
+        return psr[PORT - 6];
+    }
+
+    /// Drive a pin's pad level
+    static void level(uint8_t pin, bool high) {
+        const auto g = example::teensy41::gpioOf(pin);
+        if (high) psr[g.port - 6] |= 1u << g.bit;
+        else psr[g.port - 6] &= ~(1u << g.bit);
+    }
+};
+
+// The example's wiring: buttons on 32 and 35 (GPIO7), encoder switch on 4 (GPIO9)
+constexpr std::array<ButtonPin, 3> PINS = {{
+    {.id = 1, .pin = 32, .activeLow = true},
+    {.id = 2, .pin = 35, .activeLow = true},
+    {.id = 3, .pin = 4, .activeLow = false},
+}};
+
+using Source = example::GpioButtonSource<PINS.size(), PINS, SimGpio>;
+using Pipeline = example::InputPipeline<16, 4>;
+
+void testPinMapIsABijection() {
+    std::set<std::pair<uint8_t, uint8_t>> seen;
+    for (uint8_t pin = 0; pin < example::teensy41::PIN_COUNT; ++pin) {
+        const auto g = example::teensy41::gpioOf(pin);
+        CHECK(g.port >= 6 && g.port <= 9 && g.bit < 32);
+        CHECK(seen.insert({g.port, g.bit}).second);
+    }
+    // Well-known pins: LED (13), Serial1 RX/TX (0/1)
+    static_assert(example::teensy41::gpioOf(13).port == 7 && example::teensy41::gpioOf(13).bit == 3);
+    static_assert(example::teensy41::gpioOf(0).port == 6 && example::teensy41::gpioOf(0).bit == 3);
+    static_assert(example::teensy41::gpioOf(1).port == 6 && example::teensy41::gpioOf(1).bit == 2);
+    static_assert(example::teensy41::psrAddress(6) == 0x42000008u);
+    static_assert(example::teensy41::psrAddress(9) == 0x4200C008u);
+}
+
+void testOneReadPerPort() {
+    static_assert(Source::portReads() == 2, "Pins 32/35 share GPIO7, pin 4 is on GPIO9");
+    Source source{5000};
+    SimGpio::configured.clear();
+    source.begin();
+    CHECK_EQ(SimGpio::configured.size(), 3u);
+    CHECK(SimGpio::configured[0] == std::make_pair(uint8_t(32), true));
+
+    SimGpio::reads = 0;
+    source.scan();
+    CHECK_EQ(SimGpio::reads, 2u);
+}
+
+void testLevelsAndPolarity() {
+    Source source{5000};
+    SimGpio::psr = {};
+    SimGpio::level(32, true);  // Released (active low, pulled up)
+    SimGpio::level(35, true);
+    CHECK_EQ(source.scan(), 0u);
+    SimGpio::level(35, false);  // Pressed
+    CHECK_EQ(source.scan(), 0b010u);
+    SimGpio::level(4, true);    // Active high
+    CHECK_EQ(source.scan(), 0b110u);
+    SimGpio::level(32, false);
+    SimGpio::level(35, true);
+    SimGpio::level(4, false);
+    CHECK_EQ(source.scan(), 0b001u);
+}
+
+void testDebouncedEdgesReachThePipeline() {
+    Source source{5000};
+    Pipeline input;
+    std::vector<example::InputEvent> events;
+    auto collect = [&](uint32_t now) {
+        input.dispatch(now, [&](const example::InputEvent& e) { events.push_back(e); });
+    };
+    SimGpio::psr = {};
+    SimGpio::level(32, true);
+    SimGpio::level(35, true);
+    source.poll(input, 0);
+    source.poll(input, 10000);
+    collect(10000);
+    CHECK(events.empty());
+
+    // Button 1 bounces for 3 ms, then stays pressed
+    uint32_t t = 20000;
+    for (int i = 0; i < 6; ++i, t += 500) {
+        SimGpio::level(32, i % 2 != 0);
+        source.poll(input, t);
+    }
+    SimGpio::level(32, false);
+    for (; t < 40000; t += 1000) source.poll(input, t);
+    collect(t);
+    CHECK_EQ(events.size(), 1u);
+    CHECK(events[0].id == 1 && events[0].type == example::InputType::PRESS);
+    CHECK(events[0].timeUs >= 20000 + 2500 + 5000);  // Settled for the debounce window
+
+    SimGpio::level(32, true);
+    for (; t < 60000; t += 1000) source.poll(input, t);
+    collect(t);
+    CHECK_EQ(events.size(), 2u);
+    CHECK(events[1].type == example::InputType::RELEASE);
+}
+
+}  // namespace
+
+int main() {
+    testPinMapIsABijection();
+    testOneReadPerPort();
+    testLevelsAndPolarity();
+    testDebouncedEdgesReachThePipeline();
+    return check::result("gpio_button_source");
+}
@@ -0,0 +1,239 @@
+/**
+ * @file test_input_pipeline.cpp
+ * @brief InputPipeline: one queue, one binding table, gestures from the same timestamps
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "InputPipeline.hpp"
+#include "MidiActions.hpp"
+#include "ToggleBank.hpp"
+#include "check.hpp"
+
+namespace {
+
+using example::InputEvent;
+using example::InputSource;
+using example::InputType;
+using Pipeline = example::InputPipeline<16, 16>;
+
+constexpr uint32_t MS = 1000;
+
+struct Log {
+    std::vector<InputEvent> events;
+    void add(const InputEvent& e) { events.push_back(e); }
+    size_t count(InputType type) const {
+        size_t n = 0;
+        for (const InputEvent& e : events) n += e.type == type;
+        return n;
+    }
+};
+
+Pipeline makePipeline() { return Pipeline{{.longPressUs = 500 * MS, .doubleTapUs = 300 * MS}}; }
+
+void testEventsKeepQueueOrderAcrossSources() {
+    Pipeline input = makePipeline();
+    Log log;
+    input.pushButton(1, true, 10);
+    input.pushEncoder(1, 2, 20);
+    input.pushEncoder(1, 0, 25);  // Zero steps: not an event
+    input.pushButton(1, false, 30);
+    CHECK_EQ(input.pending(), 3u);
+    CHECK_EQ(input.dispatch(40, [&](const InputEvent& e) { log.add(e); }), 3u);
+    CHECK_EQ(log.events.size(), 3u);
+    CHECK(log.events[0].type == InputType::PRESS);
+    CHECK(log.events[1].source == InputSource::ENCODER && log.events[1].delta == 2);
+    CHECK(log.events[2].type == InputType::RELEASE);
+    CHECK_EQ(input.pending(), 0u);
+}
+
+void testMostSpecificBindingWins() {
+    Pipeline input = makePipeline();
+    struct Counts { int coarse = 0, fine = 0; } counts;
+    Counts* c = &counts;
+    input.onEncoder(1).turn().then([c]() { ++c->coarse; });
+    input.onButton(1).held().onEncoder(1).turn().then([c]() { ++c->fine; });
+
+    input.pushEncoder(1, 1, 0);
+    input.dispatch(0);
+    input.pushButton(1, true, 1);
+    input.pushEncoder(1, 1, 2);
+    input.pushButton(1, false, 3);
+    input.pushEncoder(1, 1, 4);
+    input.dispatch(5);
+    CHECK_EQ(counts.coarse, 2);
+    CHECK_EQ(counts.fine, 1);
+}
+
+void testLongPressFiresOncePerHold() {
+    Pipeline input = makePipeline();
+    int longPresses = 0;
+    int* n = &longPresses;
+    input.onButton(1).longPress().then([n]() { ++*n; });
+
+    Log log;
+    auto visit = [&](const InputEvent& e) { log.add(e); };
+    input.pushButton(1, true, 1000);
+    input.dispatch(1000, visit);
+    input.dispatch(1000 + 499 * MS, visit);
+    CHECK_EQ(longPresses, 0);
+    input.dispatch(1000 + 500 * MS, visit);
+    CHECK_EQ(longPresses, 1);
+    CHECK_EQ(log.events.back().timeUs, 1000 + 500 * MS);  // Stamped when it matured
+    input.dispatch(1000 + 900 * MS, visit);
+    CHECK_EQ(longPresses, 1);
+
+    // Press and release both waiting in the queue (a stalled tick): the
+    // long press still comes before the release
+    input.pushButton(1, false, 1000 + 950 * MS);
+    input.pushButton(1, true, 2000 * MS);
+    input.pushButton(1, false, 2700 * MS);
+    log.events.clear();
+    input.dispatch(3000 * MS, visit);
+    CHECK_EQ(longPresses, 2);
+    CHECK(log.events.size() == 4 && log.events[2].type == InputType::LONG_PRESS);
+
+    // A short press: no long press, even long after the release
+    input.pushButton(1, true, 4000 * MS);
+    input.pushButton(1, false, 4100 * MS);
+    input.dispatch(5000 * MS);
+    CHECK_EQ(longPresses, 2);
+}
+
+void testDoubleTapPairsPresses() {
+    Pipeline input = makePipeline();
+    Log log;
+    auto visit = [&](const InputEvent& e) { log.add(e); };
+    uint32_t t = 0;
+    auto tap = [&](uint32_t at) {
+        input.pushButton(2, true, at);
+        input.pushButton(2, false, at + 50 * MS);
+        input.dispatch(at + 60 * MS, visit);
+    };
+    tap(t);
+    tap(t += 200 * MS);  // Double tap
+    tap(t += 200 * MS);  // Third press starts a new pair
+    CHECK_EQ(log.count(InputType::DOUBLE_TAP), 1u);
+    tap(t += 200 * MS);  // Pairs with the third
+    CHECK_EQ(log.count(InputType::DOUBLE_TAP), 2u);
+    tap(t += 400 * MS);  // Too slow
+    tap(t += 400 * MS);
+    CHECK_EQ(log.count(InputType::DOUBLE_TAP), 2u);
+
+    // The gesture event follows its press
+    for (size_t i = 0; i < log.events.size(); ++i) {
+        if (log.events[i].type == InputType::DOUBLE_TAP) CHECK(log.events[i - 1].type == InputType::PRESS);
+    }
+}
+
+void testToggleResetByDoubleTapStaysOff() {
+    // Wired like main.cpp: the toggle flips on every press (visitor), the
+    // double tap resets it (binding). Both resolve in one pass, in event
+    // order, so the reset always lands after the second flip.
+    Pipeline input = makePipeline();
+    example::ToggleBank<8> toggles;
+    toggles.bindToggle(2, 0);
+    example::ToggleBank<8>* bank = &toggles;
+    input.onButton(2).doubleTap().then([bank]() { bank->set(0, false, [](uint16_t, bool) {}); });
+    auto visit = [&](const InputEvent& e) { toggles.handle(e, [](uint16_t, bool) {}); };
+
+    // Both taps queued before one dispatch, then one tap per dispatch
+    input.pushButton(2, true, 0);
+    input.pushButton(2, false, 30 * MS);
+    input.pushButton(2, true, 100 * MS);
+    input.pushButton(2, false, 130 * MS);
+    input.dispatch(140 * MS, visit);
+    CHECK(!toggles.get(0));
+
+    input.pushButton(2, true, 1000 * MS);
+    input.dispatch(1010 * MS, visit);
+    CHECK(toggles.get(0));
+    input.pushButton(2, false, 1030 * MS);
+    input.pushButton(2, true, 1100 * MS);
+    input.dispatch(1110 * MS, visit);
+    CHECK(!toggles.get(0));
+}
+
+void testActionTableIgnoresGestures() {
+    constexpr std::array<example::MidiAction, 1> ACTIONS = {{example::sendNote(1, 0, 60, 100)}};
+    example::ActionTable<1> actions{ACTIONS};
+    Pipeline input = makePipeline();
+    int noteOffs = 0;
+    input.pushButton(1, true, 0);
+    input.dispatch(600 * MS, [&](const InputEvent& e) {
+        actions.run(e, [&](const example::MidiMessage& m) {
+            noteOffs += m.kind == example::MidiMessage::Kind::NOTE_OFF;
+        });
+    });
+    CHECK_EQ(noteOffs, 0);  // The long press is not a release
+}
+
+void testModifierHoldSwallowsOnlyItsLongPress() {
+    Pipeline input = makePipeline();
+    int fine = 0, longPresses = 0;
+    int* f = &fine;
+    int* l = &longPresses;
+    input.onButton(1).held().onEncoder(1).turn().then([f]() { ++*f; });
+    input.onButton(1).longPress().then([l]() { ++*l; });
+    constexpr std::array<example::MidiAction, 1> ACTIONS = {{example::momentaryCC(1, 0, 20)}};
+    example::ActionTable<1> actions{ACTIONS};
+    std::vector<uint8_t> cc;
+    auto visit = [&](const InputEvent& e) {
+        actions.run(e, [&](const example::MidiMessage& m) { cc.push_back(m.value); });
+    };
+
+    // Hold, turn, keep holding past the long-press time, release: the CC
+    // follows the button, the long press is dropped
+    input.pushButton(1, true, 0);
+    input.dispatch(10 * MS, visit);
+    CHECK_EQ(input.heldMask(), 1u << 1);
+    CHECK(cc.size() == 1 && cc[0] == 127);  // Sent on press, not on release
+    input.pushEncoder(1, 1, 100 * MS);
+    input.dispatch(100 * MS, visit);
+    CHECK_EQ(input.modifyingMask(), 1u << 1);
+    input.dispatch(900 * MS, visit);
+    input.pushButton(1, false, 1000 * MS);
+    input.dispatch(1000 * MS, visit);
+    CHECK_EQ(fine, 1);
+    CHECK_EQ(longPresses, 0);
+    CHECK(cc.size() == 2 && cc[1] == 0);
+    CHECK_EQ(input.heldMask(), 0u);
+    CHECK_EQ(input.modifyingMask(), 0u);
+
+    // A long hold without turning: press, then long press, then the turn
+    // still fine-adjusts and the release pairs with the press
+    cc.clear();
+    input.pushButton(1, true, 3000 * MS);
+    input.dispatch(3600 * MS, visit);
+    CHECK_EQ(longPresses, 1);
+    CHECK(cc.size() == 1 && cc[0] == 127);
+    input.pushEncoder(1, 1, 3700 * MS);
+    input.pushButton(1, false, 3800 * MS);
+    input.dispatch(3800 * MS, visit);
+    CHECK_EQ(fine, 2);
+    CHECK(cc.size() == 2 && cc[1] == 0);
+}
+
+void testOverflowCountsDrops() {
+    Pipeline input = makePipeline();
+    for (int i = 0; i < 20; ++i) input.pushEncoder(1, 1, static_cast<uint32_t>(i));
+    CHECK_EQ(input.pending(), 16u);
+    CHECK_EQ(input.dropped(), 4u);
+    CHECK_EQ(input.highWater(), 16u);
+    CHECK_EQ(input.dispatch(100), 16u);
+}
+
+}  // namespace
+
+int main() {
+    testEventsKeepQueueOrderAcrossSources();
+    testMostSpecificBindingWins();
+    testLongPressFiresOncePerHold();
+    testDoubleTapPairsPresses();
+    testToggleResetByDoubleTapStaysOff();
+    testModifierHoldSwallowsOnlyItsLongPress();
+    testActionTableIgnoresGestures();
+    testOverflowCountsDrops();
+    return check::result("input_pipeline");
+}
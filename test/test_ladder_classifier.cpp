@@ -0,0 +1,84 @@
+/**
+ * @file test_ladder_classifier.cpp
+ * @brief LadderClassifier: nearest band on entry, previous key held across boundaries
+ */
+
+#include <array>
+#include <cstdint>
+
+#include "LadderClassifier.hpp"
+#include "check.hpp"
+
+namespace {
+
+using Ladder = example::LadderClassifier<4>;
+constexpr uint8_t NONE = Ladder::NONE;
+
+constexpr std::array<uint16_t, 4> CENTERS = {100, 300, 500, 700};
+constexpr uint16_t IDLE = 1000;
+
+void testCentersAndIdle() {
+    Ladder ladder{CENTERS, IDLE, 20};
+    CHECK_EQ(ladder.classify(1000), NONE);
+    for (uint8_t b = 0; b < 4; ++b) {
+        CHECK_EQ(ladder.classify(CENTERS[b]), b);
+        CHECK_EQ(ladder.classify(IDLE), NONE);
+    }
+}
+
+void testBoundaryHoldsThePreviousKey() {
+    Ladder ladder{CENTERS, IDLE, 20};
+    // Boundary between bands 0 and 1 is 200; a held key extends 20 past it
+    CHECK_EQ(ladder.classify(100), 0);
+    CHECK_EQ(ladder.classify(200), 0);
+    CHECK_EQ(ladder.classify(220), 0);
+    CHECK_EQ(ladder.classify(221), 1);
+    CHECK_EQ(ladder.classify(200), 1);  // Same reading, other side: held
+    CHECK_EQ(ladder.classify(180), 1);
+    CHECK_EQ(ladder.classify(179), 0);
+
+    // Noise of +-15 counts around the boundary never chatters
+    uint8_t first = ladder.classify(200);
+    for (int i = 0; i < 100; ++i) {
+        CHECK_EQ(ladder.classify(static_cast<uint16_t>(200 + (i % 31) - 15)), first);
+    }
+}
+
+void testIdleHoldsToo() {
+    Ladder ladder{CENTERS, IDLE, 20};
+    // Boundary between band 3 (700) and idle (1000) is 850
+    CHECK_EQ(ladder.classify(IDLE), NONE);
+    CHECK_EQ(ladder.classify(840), NONE);
+    CHECK_EQ(ladder.classify(831), NONE);
+    CHECK_EQ(ladder.classify(829), 3);
+    CHECK_EQ(ladder.classify(860), 3);
+    CHECK_EQ(ladder.classify(871), NONE);
+}
+
+void testCloseBandsStayReachable() {
+    // Hysteresis larger than half the gap: capped, every band still reachable
+    Ladder ladder{{100, 130, 160, 700}, IDLE, 50};
+    CHECK_EQ(ladder.classify(130), 1);
+    CHECK_EQ(ladder.classify(160), 2);
+    CHECK_EQ(ladder.classify(100), 0);
+    CHECK_EQ(ladder.classify(130), 1);  // A neighbour's center always switches
+}
+
+void testUnsortedCenters() {
+    Ladder ladder{{700, 100, 500, 300}, IDLE, 10};
+    CHECK_EQ(ladder.classify(105), 1);
+    CHECK_EQ(ladder.classify(295), 3);
+    CHECK_EQ(ladder.classify(690), 0);
+    CHECK_EQ(ladder.classify(995), NONE);
+}
+
+}  // namespace
+
+int main() {
+    testCentersAndIdle();
+    testBoundaryHoldsThePreviousKey();
+    testIdleHoldsToo();
+    testCloseBandsStayReachable();
+    testUnsortedCenters();
+    return check::result("ladder_classifier");
+}
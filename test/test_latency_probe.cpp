@@ -0,0 +1,151 @@
+/**
+ * @file test_latency_probe.cpp
+ * @brief LatencyProbe against a simulated loopback: stats, losses, late echoes
+ *
+ * The loopback plays both the USB link and tools/latency_echo.py: a probe
+ * reaches the host after an outbound delay, the host sends the same bytes
+ * back, and they reach the device after the return delay. The device runs
+ * 10 us ticks, as its update() would.
+ */
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#include "LatencyProbe.hpp"
+#include "check.hpp"
+
+namespace {
+
+using Probe = example::LatencyProbe<64>;
+using example::LatencyReport;
+
+constexpr uint32_t TICK_US = 10;
+constexpr uint32_t INTERVAL_US = 2000;
+constexpr uint32_t TIMEOUT_US = 10000;
+
+struct InFlight {
+    uint32_t arrivesUs;
+    std::vector<uint8_t> bytes;
+};
+
+/**
+ * Round trip for the probe with sequence seq; a negative value drops it.
+ * Echoes are delivered by arrival time, so a late one can be overtaken.
+ */
+using DelayFn = std::function<int32_t(uint8_t seq)>;
+
+struct Loopback {
+    Probe probe{INTERVAL_US, TIMEOUT_US};
+    DelayFn roundTrip;
+    std::deque<InFlight> echoes;
+    uint32_t nowUs;
+    uint32_t lateEchoes = 0;
+
+    Loopback(DelayFn delay, uint32_t startUs = 1000) : roundTrip(std::move(delay)), nowUs(startUs) {}
+
+    /// Runs until the probe reports; returns the report
+    LatencyReport run(uint32_t count) {
+        probe.start(count);
+        for (uint32_t guard = 0; guard < 10000000; ++guard) {
+            while (!echoes.empty() && nowUs - echoes.front().arrivesUs < 0x80000000u) {
+                const auto& e = echoes.front();
+                const uint32_t before = probe.report().received;
+                CHECK(probe.onEcho(e.bytes.data(), e.bytes.size(), nowUs));
+                if (probe.report().received == before) ++lateEchoes;
+                echoes.pop_front();
+            }
+            const bool done = probe.service(nowUs, [this](const uint8_t* data, size_t size) {
+                const int32_t delay = roundTrip(data[4]);
+                if (delay < 0) return;
+                const uint32_t arrivesUs = nowUs + uint32_t(delay);
+                auto at = echoes.end();
+                while (at != echoes.begin() && arrivesUs - std::prev(at)->arrivesUs > 0x80000000u) --at;
+                echoes.insert(at, {arrivesUs, {data, data + size}});
+            });
+            if (done) return probe.report();
+            nowUs += TICK_US;
+        }
+        CHECK(false);  // Never finished
+        return probe.report();
+    }
+};
+
+void testRoundTripStatistics() {
+    // Round trips 100, 110, ... 1090 us, one per probe
+    Loopback link{[](uint8_t seq) { return int32_t(100 + 10 * seq); }};
+    const LatencyReport r = link.run(100);
+    CHECK(!link.probe.running());
+    CHECK_EQ(r.sent, 100u);
+    CHECK_EQ(r.received, 64u + 36u);  // Every echo counts; samples cap at 64
+    CHECK_EQ(r.lost, 0u);
+
+    // Samples are the first 64: 100 .. 730, measured to the tick
+    CHECK(r.minUs >= 100 && r.minUs < 100 + TICK_US);
+    CHECK(r.maxUs >= 730 && r.maxUs < 730 + TICK_US);
+    CHECK(r.p50Us >= 410 && r.p50Us < 410 + TICK_US);
+    CHECK(r.p99Us >= 710 && r.p99Us < 730 + TICK_US);
+    CHECK(r.p90Us <= r.p99Us);
+    CHECK_EQ(r.oneWayP50Us, r.p50Us / 2);
+}
+
+void testLostAndLateEchoes() {
+    // Every 4th probe dropped, every 4th+1 answered after the timeout
+    Loopback link{[](uint8_t seq) {
+        if (seq % 4 == 0) return int32_t(-1);
+        if (seq % 4 == 1) return int32_t(TIMEOUT_US + 500);
+        return int32_t(300);
+    }};
+    const LatencyReport r = link.run(40);
+    CHECK_EQ(r.sent, 40u);
+    CHECK_EQ(r.lost, 20u);
+    CHECK_EQ(r.received, 20u);
+    CHECK_EQ(link.lateEchoes, 10u);  // Recognized as ours, never counted
+    CHECK(r.minUs >= 300 && r.maxUs < 300 + TICK_US);
+}
+
+void testClockWrapDuringARun() {
+    Loopback link{[](uint8_t) { return int32_t(250); }, 0xFFFFFFFFu - 5 * INTERVAL_US};
+    const LatencyReport r = link.run(20);
+    CHECK_EQ(r.received, 20u);
+    CHECK(r.maxUs < 250 + TICK_US);
+}
+
+void testStartRequest() {
+    uint32_t count = 0;
+    const uint8_t withCount[] = {0xF0, 0x7D, 0x03, Probe::SYSEX_START, 25, 0xF7};
+    CHECK(Probe::isStart(withCount, sizeof(withCount), count));
+    CHECK_EQ(count, 25u);
+
+    const uint8_t noCount[] = {0xF0, 0x7D, 0x03, Probe::SYSEX_START, 0xF7};
+    CHECK(Probe::isStart(noCount, sizeof(noCount), count));
+    CHECK_EQ(count, 100u);
+
+    const uint8_t query[] = {0xF0, 0x7D, 0x03, 0x01, 0xF7};
+    CHECK(!Probe::isStart(query, sizeof(query), count));
+}
+
+void testReportEncoding() {
+    Loopback link{[](uint8_t) { return int32_t(640); }};
+    link.run(5);
+    uint8_t message[Probe::REPORT_MAX];
+    const size_t size = link.probe.encodeReport(message);
+    CHECK_EQ(size, Probe::REPORT_MAX);
+    CHECK_EQ(message[0], 0xF0);
+    CHECK_EQ(message[3], Probe::SYSEX_REPORT);
+    CHECK_EQ(message[size - 1], 0xF7);
+    for (size_t i = 1; i + 1 < size; ++i) CHECK(message[i] < 0x80);
+}
+
+}  // namespace
+
+int main() {
+    testRoundTripStatistics();
+    testLostAndLateEchoes();
+    testClockWrapDuringARun();
+    testStartRequest();
+    testReportEncoding();
+    return check::result("LatencyProbe");
+}
@@ -0,0 +1,110 @@
+/**
+ * @file test_led_bank.cpp
+ * @brief LedBank: bit packing, transfer-on-change, BAM plane timing
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "LedBank.hpp"
+#include "check.hpp"
+
+namespace {
+
+/// Records the last write and counts them
+struct FakeBus {
+    std::array<uint8_t, 4> last{};
+    size_t lastCount = 0;
+    int writes = 0;
+
+    void write(const uint8_t* bytes, size_t count) {
+        for (size_t i = 0; i < count; ++i) last[i] = bytes[i];
+        lastCount = count;
+        ++writes;
+    }
+};
+
+constexpr uint32_t UNIT_US = 250;
+
+void testFirstFlushLatchesTheBank() {
+    example::LedBank<8> leds{UNIT_US};
+    FakeBus bus;
+    CHECK(leds.flush(bus, 0));
+    CHECK_EQ(bus.lastCount, 1u);
+    CHECK_EQ(bus.last[0], 0);
+    CHECK(!leds.flush(bus, 100));
+    CHECK_EQ(leds.transfers(), 1u);
+}
+
+void testBitsArePackedPerLed() {
+    example::LedBank<12> leds{UNIT_US};
+    FakeBus bus;
+    leds.setOn(0, true);
+    leds.setOn(3, true);
+    leds.setOn(9, true);
+    leds.setOn(12, true);  // Out of range: ignored
+    CHECK(leds.flush(bus, 0));
+    CHECK_EQ(bus.lastCount, 2u);
+    CHECK_EQ(bus.last[0], 0x09);
+    CHECK_EQ(bus.last[1], 0x02);
+}
+
+void testStaticPanelCausesNoTraffic() {
+    example::LedBank<8> leds{UNIT_US};
+    FakeBus bus;
+    leds.setOn(1, true);
+    leds.setOn(5, true);
+    leds.flush(bus, 0);
+
+    // Full on/off: every plane is the same, so no plane change is written
+    for (uint32_t t = 0; t < 100000; t += 100) leds.flush(bus, t);
+    CHECK_EQ(bus.writes, 1);
+
+    // Same level again: not even a rebuild
+    leds.setOn(1, true);
+    CHECK(!leds.flush(bus, 100000));
+    leds.setOn(1, false);
+    CHECK(leds.flush(bus, 100100));
+    CHECK_EQ(bus.last[0], 0x20);
+}
+
+void testBamPlanesAreBinaryWeighted() {
+    // Level 0x50: top 4 bits 0101, on in planes 0 and 2 (1 + 4 of 15 units)
+    example::LedBank<8> leds{UNIT_US};
+    FakeBus bus;
+    leds.set(0, 0x50);
+
+    uint32_t onUs = 0;
+    constexpr uint32_t CYCLE_US = 15 * UNIT_US;
+    constexpr uint32_t TICK_US = 50;
+    for (uint32_t t = 0; t < 20 * CYCLE_US; t += TICK_US) {
+        leds.flush(bus, t);
+        if (bus.last[0] & 1) onUs += TICK_US;
+    }
+    // 5/15 duty, give or take the tick rounding of each plane
+    const uint32_t expected = 20 * CYCLE_US * 5 / 15;
+    CHECK(onUs > expected * 9 / 10);
+    CHECK(onUs < expected * 11 / 10);
+}
+
+void testLevelsBelowTheResolutionAreOff() {
+    example::LedBank<8> leds{UNIT_US};
+    FakeBus bus;
+    leds.set(0, 0x0F);  // Under the top 4 bits
+    CHECK_EQ(leds.get(0), 0x0F);
+    for (uint32_t t = 0; t < 10000; t += 50) leds.flush(bus, t);
+    CHECK_EQ(bus.writes, 1);
+    CHECK_EQ(bus.last[0], 0);
+}
+
+}  // namespace
+
+int main() {
+    testFirstFlushLatchesTheBank();
+    testBitsArePackedPerLed();
+    testStaticPanelCausesNoTraffic();
+    testBamPlanesAreBinaryWeighted();
+    testLevelsBelowTheResolutionAreOff();
+    return check::result("LedBank");
+}
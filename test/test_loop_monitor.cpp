@@ -0,0 +1,119 @@
+/**
+ * @file test_loop_monitor.cpp
+ * @brief LoopMonitor on a virtual clock: period histogram and overrun culprit
+ *
+ * A binding handler that burns 6 ms is injected into an InputPipeline wired
+ * to the monitor the way main.cpp wires it (handler probe -> stage): the
+ * overrun must name the "binding" stage and that binding's key.
+ */
+
+#include <cstdint>
+#include <string_view>
+
+#include "Clock.hpp"
+#include "InputPipeline.hpp"
+#include "LoopMonitor.hpp"
+#include "check.hpp"
+#include "sim.hpp"
+
+namespace {
+
+using sim::VirtualClock;
+
+using Pipeline = example::InputPipeline<16, 8>;
+
+void testHistogramBuckets() {
+    VirtualClock clock{1000};
+    example::LoopMonitor monitor{example::Clock::from(clock), 2000};
+    for (int i = 0; i < 10; ++i) {
+        monitor.beginTick();
+        clock.us += 100;
+        monitor.endTick();
+        clock.us += 900;  // 1000 us period
+    }
+    const auto& h = monitor.periodHistogram();
+    CHECK_EQ(h[9], 9u);  // [512, 1024)
+    uint32_t total = 0;
+    for (uint32_t n : h) total += n;
+    CHECK_EQ(total, 9u);  // The first tick has no period
+    CHECK_EQ(monitor.lastOverrun().count, 0u);
+    CHECK_EQ(monitor.maxTickUs(), 100u);
+}
+
+/// As main.cpp wires it: handler time to "binding", the rest back to "dispatch"
+void wireProbe(Pipeline& input, example::LoopMonitor& monitor) {
+    input.setHandlerProbe(
+        [](void* m, uint16_t key) { static_cast<example::LoopMonitor*>(m)->stage("binding", key); },
+        [](void* m) { static_cast<example::LoopMonitor*>(m)->stage("dispatch"); }, &monitor);
+}
+
+void testSlowHandlerIsTheCulprit() {
+    VirtualClock clock{1000};
+    example::LoopMonitor monitor{example::Clock::from(clock), 2000};
+    Pipeline input;
+    VirtualClock* c = &clock;
+    input.onButton(1).press().then([c]() { c->us += 200; });
+    input.onButton(2).press().then([c]() { c->us += 6000; });  // The slow one
+    wireProbe(input, monitor);
+
+    // A normal tick first
+    monitor.beginTick();
+    monitor.stage("dispatch");
+    input.pushButton(1, true, clock.us);
+    input.dispatch(clock.us);
+    monitor.stage("midi");
+    clock.us += 300;
+    monitor.endTick();
+    CHECK_EQ(monitor.lastOverrun().count, 0u);
+
+    // The slow handler runs among others in one tick
+    clock.us += 500;
+    monitor.beginTick();
+    monitor.stage("dispatch");
+    clock.us += 50;
+    input.pushButton(1, false, clock.us);
+    input.pushButton(2, true, clock.us);
+    input.dispatch(clock.us);
+    monitor.stage("midi");
+    clock.us += 300;
+    monitor.endTick();
+
+    const auto& overrun = monitor.lastOverrun();
+    CHECK_EQ(overrun.count, 1u);
+    CHECK_EQ(overrun.tickUs, 50u + 6000u + 300u);
+    CHECK(std::string_view(overrun.stage) == "binding");
+    CHECK_EQ(overrun.stageArg, 0x0002);  // BUTTON / PRESS / id 2
+    CHECK_EQ(overrun.stageUs, 6000u);
+    CHECK_EQ(monitor.maxTickUs(), overrun.tickUs);
+}
+
+void testWorkAfterAHandlerIsNotChargedToIt() {
+    VirtualClock clock{1000};
+    example::LoopMonitor monitor{example::Clock::from(clock), 2000};
+    Pipeline input;
+    VirtualClock* c = &clock;
+    input.onButton(1).press().then([c]() { c->us += 100; });
+    wireProbe(input, monitor);
+
+    // A slow visitor (e.g. the action table) after a fast handler
+    monitor.beginTick();
+    monitor.stage("dispatch");
+    input.pushButton(1, true, clock.us);
+    input.dispatch(clock.us, [&](const example::InputEvent&) { clock.us += 5000; });
+    monitor.stage("midi");
+    monitor.endTick();
+
+    const auto& overrun = monitor.lastOverrun();
+    CHECK_EQ(overrun.count, 1u);
+    CHECK(std::string_view(overrun.stage) == "dispatch");
+    CHECK_EQ(overrun.stageUs, 5000u);
+}
+
+}  // namespace
+
+int main() {
+    testHistogramBuckets();
+    testSlowHandlerIsTheCulprit();
+    testWorkAfterAHandlerIsNotChargedToIt();
+    return check::result("loop_monitor");
+}
@@ -0,0 +1,101 @@
+/**
+ * @file test_metrics.cpp
+ * @brief Metrics: SysEx framing, 7-bit packing round trip, rate and loop counters
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Metrics.hpp"
+#include "check.hpp"
+
+namespace {
+
+using example::Metrics;
+using example::MetricsBlock;
+
+/// Inverse of the packing in Metrics::encodeSysEx() (what tools/metrics_reader.py does)
+std::vector<uint8_t> unpack7(const uint8_t* data, size_t size) {
+    std::vector<uint8_t> raw;
+    for (size_t i = 0; i < size; i += 8) {
+        const uint8_t msbs = data[i];
+        for (size_t j = 1; j < 8 && i + j < size; ++j) {
+            raw.push_back(static_cast<uint8_t>(data[i + j] | (((msbs >> (j - 1)) & 1) << 7)));
+        }
+    }
+    return raw;
+}
+
+void testResponseRoundTrip() {
+    MetricsBlock block;
+    block.uptimeMs = 0x89ABCDEF;
+    block.eventsTotal = 0xFFFFFFFF;
+    block.maxLoopUs = 0x80808080;
+    block.midiQueueMeanUs = 125;
+
+    uint8_t message[Metrics::RESPONSE_MAX];
+    const size_t size = Metrics::encodeResponse(block, message);
+    CHECK(size <= Metrics::RESPONSE_MAX);
+    CHECK_EQ(message[0], 0xF0);
+    CHECK_EQ(message[size - 1], 0xF7);
+    CHECK(Metrics::isCommand(message, size, Metrics::SYSEX_RESPONSE));
+    for (size_t i = 1; i < size - 1; ++i) CHECK(message[i] < 0x80);
+
+    const std::vector<uint8_t> raw = unpack7(message + 4, size - 5);
+    CHECK_EQ(raw.size(), sizeof(MetricsBlock));
+    MetricsBlock decoded;
+    std::memcpy(&decoded, raw.data(), sizeof(decoded));
+    CHECK_EQ(decoded.version, MetricsBlock::VERSION);
+    CHECK_EQ(decoded.size, sizeof(MetricsBlock));
+    CHECK_EQ(decoded.uptimeMs, block.uptimeMs);
+    CHECK_EQ(decoded.eventsTotal, block.eventsTotal);
+    CHECK_EQ(decoded.maxLoopUs, block.maxLoopUs);
+    CHECK_EQ(decoded.midiQueueMeanUs, block.midiQueueMeanUs);
+}
+
+void testCommandFraming() {
+    const uint8_t framed[] = {0xF0, 0x7D, 0x03, 0x01, 0xF7};
+    const uint8_t bare[] = {0x7D, 0x03, 0x01};
+    const uint8_t resync[] = {0xF0, 0x7D, 0x03, 0x03, 0xF7};
+    const uint8_t other[] = {0xF0, 0x7E, 0x03, 0x01, 0xF7};
+    CHECK(Metrics::isQuery(framed, sizeof(framed)));
+    CHECK(Metrics::isQuery(bare, sizeof(bare)));
+    CHECK(!Metrics::isQuery(resync, sizeof(resync)));
+    CHECK(Metrics::isCommand(resync, sizeof(resync), Metrics::SYSEX_RESYNC));
+    CHECK(!Metrics::isQuery(other, sizeof(other)));
+    CHECK(!Metrics::isQuery(framed, 2));
+}
+
+void testRateAndLoopCounters() {
+    Metrics metrics;
+    uint32_t now = 1000;
+    for (int i = 0; i < 100; ++i) {
+        metrics.countEvents(3);
+        metrics.tick(now);
+        now += i == 50 ? 4000 : 1000;  // One slow loop
+    }
+    metrics.tick(now + 1000000);  // Closes the first rate window
+    const MetricsBlock b = metrics.snapshot(42);
+    CHECK_EQ(b.uptimeMs, 42u);
+    CHECK_EQ(b.eventsTotal, 300u);
+    CHECK_EQ(b.eventsPerSecond, 300u);
+    CHECK_EQ(b.maxLoopUs, 1000000u + 1000u);
+
+    Metrics steady;
+    now = 1000;
+    for (int i = 0; i < 100; ++i) {
+        steady.tick(now);
+        now += i == 50 ? 4000 : 1000;
+    }
+    CHECK_EQ(steady.snapshot(0).maxLoopUs, 4000u);
+}
+
+}  // namespace
+
+int main() {
+    testResponseRoundTrip();
+    testCommandFraming();
+    testRateAndLoopCounters();
+    return check::result("metrics");
+}
@@ -0,0 +1,129 @@
+/**
+ * @file test_microframe_flush.cpp
+ * @brief MicroframeFlush: at most one commit per microframe, queueing delay stats
+ */
+
+#include <cstdint>
+
+#include "MicroframeFlush.hpp"
+#include "MidiPacketWriter.hpp"
+#include "check.hpp"
+
+namespace {
+
+using example::MicroframeFlush;
+
+/// Simulated SOF counter and endpoint: microframe = nowUs / 125
+struct SimUsb {
+    uint32_t nowUs = 0;
+    uint32_t transfers = 0;
+    uint32_t packets = 0;
+
+    uint16_t microframe() const { return static_cast<uint16_t>((nowUs / 125) & 0x3FFF); }
+    void write(uint32_t) { ++packets; }
+    void flush() { ++transfers; }
+};
+
+struct UsbPort {
+    SimUsb* usb;
+    void write(uint32_t packet) { usb->write(packet); }
+    void flush() { usb->flush(); }
+};
+
+/// One firmware tick: write `count` packets, then commit if allowed
+void tick(SimUsb& usb, example::MidiPacketWriter<UsbPort>& writer, MicroframeFlush& flush, int count) {
+    for (int i = 0; i < count; ++i) {
+        writer.write(example::packet::cc(0, 20, 1));
+        flush.noteWrite(usb.nowUs);
+    }
+    if (flush.mayCommit(usb.microframe())) {
+        writer.commit();
+        flush.committed(usb.microframe(), usb.nowUs);
+    }
+}
+
+void testNothingPendingNothingCommitted() {
+    MicroframeFlush flush;
+    CHECK(!flush.pending());
+    CHECK(!flush.mayCommit(0));
+    CHECK(!flush.mayCommit(7));
+    CHECK_EQ(flush.commits(), 0u);
+    CHECK_EQ(flush.meanDelayUs(), 0u);
+}
+
+void testAtMostOneCommitPerMicroframe() {
+    SimUsb usb;
+    example::MidiPacketWriter<UsbPort> writer{UsbPort{&usb}};
+    MicroframeFlush flush;
+
+    // 10 us ticks, a packet every tick, for 100 microframes
+    for (usb.nowUs = 0; usb.nowUs < 100 * 125; usb.nowUs += 10) tick(usb, writer, flush, 1);
+    CHECK_EQ(usb.transfers, 100u);
+    CHECK_EQ(flush.commits(), 100u);
+    CHECK_EQ(usb.packets, 1250u);
+}
+
+void testDelayIsBoundedByMicroframePlusTick() {
+    SimUsb usb;
+    example::MidiPacketWriter<UsbPort> writer{UsbPort{&usb}};
+    MicroframeFlush flush;
+
+    for (usb.nowUs = 0; usb.nowUs < 1000 * 125; usb.nowUs += 10) tick(usb, writer, flush, 1);
+    // Committed on the first tick of the next microframe: < 125 us + 10 us
+    CHECK(flush.maxDelayUs() < 135);
+    CHECK(flush.meanDelayUs() <= flush.maxDelayUs());
+
+    // A slow tick stretches it: a rate limit, not a deadline
+    tick(usb, writer, flush, 1);  // First tick of a microframe: committed
+    usb.nowUs += 10;
+    tick(usb, writer, flush, 1);  // Same microframe: held
+    usb.nowUs += 2000;
+    tick(usb, writer, flush, 0);
+    CHECK(flush.maxDelayUs() >= 2000);
+}
+
+void testOnlyTheFirstWriteOfABatchIsTimed() {
+    MicroframeFlush flush;
+    flush.noteWrite(100);
+    flush.noteWrite(150);
+    flush.noteWrite(180);
+    CHECK(flush.mayCommit(1));
+    flush.committed(1, 200);
+    CHECK_EQ(flush.maxDelayUs(), 100u);
+    CHECK(!flush.pending());
+
+    // Same microframe: a new write waits for the next one
+    flush.noteWrite(210);
+    CHECK(!flush.mayCommit(1));
+    CHECK(flush.mayCommit(2));
+}
+
+void testDelayHistogram() {
+    MicroframeFlush flush;
+    const uint32_t delays[] = {0, 1, 2, 3, 100, 5000};
+    uint16_t microframe = 0;
+    uint32_t nowUs = 0;
+    for (uint32_t d : delays) {
+        flush.noteWrite(nowUs);
+        nowUs += d;
+        flush.committed(++microframe, nowUs);
+    }
+    const auto& h = flush.delayHistogram();
+    CHECK_EQ(h[0], 2u);                            // 0, 1
+    CHECK_EQ(h[1], 2u);                            // 2, 3
+    CHECK_EQ(h[6], 1u);                            // 100: [64, 128)
+    CHECK_EQ(h[MicroframeFlush::BUCKETS - 1], 1u); // >= 2 ms
+    CHECK_EQ(flush.maxDelayUs(), 5000u);
+    CHECK_EQ(flush.meanDelayUs(), (0u + 1 + 2 + 3 + 100 + 5000) / 6);
+}
+
+}  // namespace
+
+int main() {
+    testNothingPendingNothingCommitted();
+    testAtMostOneCommitPerMicroframe();
+    testDelayIsBoundedByMicroframePlusTick();
+    testOnlyTheFirstWriteOfABatchIsTimed();
+    testDelayHistogram();
+    return check::result("MicroframeFlush");
+}
@@ -0,0 +1,93 @@
+/**
+ * @file test_midi_packet_writer.cpp
+ * @brief MidiPacketWriter: packet layout, SysEx split, commit only when pending
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MidiPacketWriter.hpp"
+#include "check.hpp"
+
+namespace {
+
+namespace packet = example::packet;
+
+struct RecordingPort {
+    std::vector<uint32_t>* packets;
+    int* flushes;
+    void write(uint32_t p) { packets->push_back(p); }
+    void flush() { ++*flushes; }
+};
+
+struct Recorder {
+    std::vector<uint32_t> packets;
+    int flushes = 0;
+    example::MidiPacketWriter<RecordingPort> writer{RecordingPort{&packets, &flushes}};
+};
+
+void testChannelPackets() {
+    // Byte 0: cable/CIN, then status, data1, data2
+    CHECK_EQ(packet::cc(2, 20, 127), 0x7F14B20Bu);
+    CHECK_EQ(packet::noteOn(0, 60, 100), 0x643C9009u);
+    CHECK_EQ(packet::noteOff(15, 60, 0), 0x003C8F08u);
+    CHECK_EQ(packet::polyPressure(1, 72, 64), 0x4048A10Au);
+    CHECK_EQ(packet::cc(0, 200, 255), packet::cc(0, 72, 127));  // Data bytes are 7-bit
+}
+
+void testCommitOnlyWhenPending() {
+    Recorder r;
+    r.writer.commit();
+    CHECK_EQ(r.flushes, 0);
+
+    r.writer.write(packet::cc(0, 20, 1));
+    r.writer.write(packet::cc(0, 21, 2));
+    CHECK_EQ(r.writer.pending(), 2u);
+    r.writer.commit();
+    r.writer.commit();
+    CHECK_EQ(r.flushes, 1);
+    CHECK_EQ(r.writer.pending(), 0u);
+    CHECK_EQ(r.writer.total(), 2u);
+}
+
+/// Reassembles the SysEx bytes, checking each CIN against its byte count
+std::vector<uint8_t> unpack(const std::vector<uint32_t>& packets, bool& ok) {
+    std::vector<uint8_t> bytes;
+    ok = !packets.empty();
+    for (size_t i = 0; i < packets.size(); ++i) {
+        const uint8_t cin = packets[i] & 0x0F;
+        const bool last = i + 1 == packets.size();
+        const size_t count = cin == 0x4 ? 3 : cin - 0x4;
+        if ((cin == 0x4) == last || count < 1 || count > 3) ok = false;
+        for (size_t b = 0; b < count; ++b) bytes.push_back(static_cast<uint8_t>(packets[i] >> (8 * (b + 1))));
+    }
+    return bytes;
+}
+
+void testSysExSplitsIntoPackets() {
+    for (size_t size = 2; size <= 11; ++size) {
+        std::vector<uint8_t> message(size);
+        message.front() = 0xF0;
+        for (size_t i = 1; i + 1 < size; ++i) message[i] = static_cast<uint8_t>(i);
+        message.back() = 0xF7;
+
+        Recorder r;
+        r.writer.writeSysEx(message.data(), message.size());
+        CHECK_EQ(r.packets.size(), (size + 2) / 3);
+        CHECK_EQ(r.writer.pending(), static_cast<uint32_t>((size + 2) / 3));
+
+        bool ok = false;
+        CHECK(unpack(r.packets, ok) == message);
+        CHECK(ok);
+    }
+}
+
+}  // namespace
+
+int main() {
+    testChannelPackets();
+    testCommitOnlyWhenPending();
+    testSysExSplitsIntoPackets();
+    return check::result("MidiPacketWriter");
+}
@@ -0,0 +1,126 @@
+/**
+ * @file test_pressure_filter.cpp
+ * @brief PressureFilter: press/release hysteresis, rate limit, dead band, final zero
+ */
+
+#include <cstdint>
+
+#include "PressureFilter.hpp"
+#include "check.hpp"
+#include "sim.hpp"
+
+namespace {
+
+using example::PressureFilter;
+
+using sim::TICK_US;
+using Feeder = sim::Feeder<PressureFilter>;
+
+/// Unsmoothed filter: every reading is the level
+PressureFilter::Tuning direct() {
+    PressureFilter::Tuning tuning;
+    tuning.smoothShift = 0;
+    return tuning;
+}
+
+void testPressAndReleaseHysteresis() {
+    PressureFilter filter{direct()};
+    Feeder pad{filter};
+
+    CHECK(!pad.feed(0).pressed);
+    CHECK(!pad.feed(119).pressed);
+
+    const auto press = pad.feed(120);
+    CHECK(press.edge);
+    CHECK(press.pressed);
+
+    CHECK(pad.feed(80).pressed);  // Between pressOff and pressOn: held
+    CHECK(!pad.feed(100).edge);
+
+    const auto release = pad.feed(79);
+    CHECK(release.edge);
+    CHECK(!release.pressed);
+    CHECK(!pad.feed(100).pressed);
+}
+
+void testPressureScale() {
+    PressureFilter filter{direct()};
+    Feeder pad{filter};
+
+    const auto full = pad.feed(900);
+    CHECK(full.edge);
+    CHECK(full.hasPressure);
+    CHECK_EQ(full.pressure, 127);
+
+    pad.nowUs += 10 * TICK_US;
+    const auto half = pad.feed(490);  // (490 - 80) * 127 / 820
+    CHECK(half.hasPressure);
+    CHECK_EQ(half.pressure, 63);
+}
+
+void testRateLimit() {
+    PressureFilter filter{direct()};
+    Feeder pad{filter};
+    pad.feed(900);
+
+    // A fast sweep: at most one update per minIntervalUs (5 ticks)
+    int sent = 0;
+    for (uint16_t raw = 900; raw > 200; raw -= 10) {
+        if (pad.feed(raw).hasPressure) ++sent;
+    }
+    CHECK_EQ(sent, 70 / 5);
+}
+
+void testDeadBand() {
+    PressureFilter filter{direct()};
+    Feeder pad{filter};
+    pad.feed(490, 10);
+    const uint8_t sent = filter.lastSent();
+
+    // One step of pressure (about 6.5 counts) is under minChange
+    CHECK(!pad.feed(497, 10).hasPressure);
+    CHECK_EQ(filter.lastSent(), sent);
+    CHECK(pad.feed(510).hasPressure);
+}
+
+void testReleaseSendsZero() {
+    PressureFilter filter{direct()};
+    Feeder pad{filter};
+    pad.feed(600, 10);
+    CHECK(filter.lastSent() > 0);
+
+    // Released right after an update: the zero is not rate limited
+    const auto release = pad.feed(0);
+    CHECK(release.edge);
+    CHECK(release.hasPressure);
+    CHECK_EQ(release.pressure, 0);
+    CHECK_EQ(filter.lastSent(), 0);
+    CHECK(!pad.feed(0, 10).hasPressure);
+}
+
+void testSmoothingDelaysThePress() {
+    PressureFilter filter;  // 1/4 per sample
+    Feeder pad{filter};
+    pad.feed(0);
+
+    // A single-sample spike does not press
+    CHECK(!pad.feed(400).pressed);
+    CHECK(!pad.feed(0, 10).pressed);
+
+    // A held press does, within a few samples
+    int samples = 0;
+    while (!pad.feed(400).pressed) ++samples;
+    CHECK(samples <= 3);
+}
+
+}  // namespace
+
+int main() {
+    testPressAndReleaseHysteresis();
+    testPressureScale();
+    testRateLimit();
+    testDeadBand();
+    testReleaseSendsZero();
+    testSmoothingDelaysThePress();
+    return check::result("PressureFilter");
+}
@@ -0,0 +1,133 @@
+/**
+ * @file test_toggle_bank.cpp
+ * @brief ToggleBank: radio groups, change callbacks across words, raw bytes, footprint
+ */
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ToggleBank.hpp"
+#include "check.hpp"
+
+namespace {
+
+using example::InputEvent;
+using example::InputSource;
+using example::InputType;
+using Bank = example::ToggleBank<64>;
+using Change = std::pair<uint16_t, bool>;
+
+InputEvent press(uint8_t id) { return {0, InputSource::BUTTON, InputType::PRESS, id, 0}; }
+
+struct Changes {
+    std::vector<Change> seen;
+    void operator()(uint16_t slot, bool on) { seen.emplace_back(slot, on); }
+};
+
+void testToggleFlipsOnPressOnly() {
+    Bank bank;
+    CHECK(bank.bindToggle(5, 63));
+    Changes changes;
+    bank.handle(press(5), changes);
+    CHECK(bank.get(63));
+    bank.handle({0, InputSource::BUTTON, InputType::RELEASE, 5, 0}, changes);
+    bank.handle({0, InputSource::BUTTON, InputType::LONG_PRESS, 5, 0}, changes);
+    bank.handle(press(5), changes);
+    CHECK(!bank.get(63));
+    CHECK(changes.seen == (std::vector<Change>{{63, true}, {63, false}}));
+}
+
+void testRadioGroupClearsAndSetsAcrossWords() {
+    // Group 0 spans the word boundary: slots 30, 31, 32, 33
+    Bank bank;
+    for (uint8_t i = 0; i < 4; ++i) CHECK(bank.bindRadio(static_cast<uint8_t>(1 + i), static_cast<uint16_t>(30 + i), 0));
+    CHECK(bank.bindToggle(9, 40));  // Not in the group
+    Changes changes;
+    bank.handle(press(9), changes);
+
+    bank.handle(press(1), changes);
+    CHECK(bank.get(30));
+    bank.handle(press(3), changes);
+    CHECK(!bank.get(30) && bank.get(32));
+    CHECK(bank.get(40));  // Outside the group: untouched
+
+    // Selecting the selected slot changes nothing
+    changes.seen.clear();
+    bank.handle(press(3), changes);
+    CHECK(bank.get(32));
+    CHECK(changes.seen.empty());
+
+    // Once per flipped bit, in slot order, whichever word it is in
+    bank.handle(press(2), changes);
+    CHECK(changes.seen == (std::vector<Change>{{31, true}, {32, false}}));
+
+    // Clearing a radio slot leaves the group empty
+    changes.seen.clear();
+    bank.set(31, false, changes);
+    CHECK(changes.seen == (std::vector<Change>{{31, false}}));
+    for (uint16_t s = 30; s <= 33; ++s) CHECK(!bank.get(s));
+
+    CHECK(!bank.bindRadio(1, 64, 0));  // Slot out of range
+    CHECK(!bank.bindRadio(1, 10, 4));  // Group out of range
+}
+
+void testWideBankReportsEveryWord() {
+    // SLOTS > 32 with a group member in each of three words
+    example::ToggleBank<96> bank;
+    bank.bindRadio(1, 5, 1);
+    bank.bindRadio(2, 40, 1);
+    bank.bindRadio(3, 90, 1);
+    Changes changes;
+    bank.handle(press(1), changes);
+    bank.handle(press(3), changes);
+    bank.handle(press(2), changes);
+    CHECK(changes.seen ==
+          (std::vector<Change>{{5, true}, {5, false}, {90, true}, {40, true}, {90, false}}));
+}
+
+void testBytesRoundTrip() {
+    Bank bank;
+    bank.bindToggle(1, 0);
+    bank.bindToggle(2, 13);
+    bank.bindToggle(3, 63);
+    Changes changes;
+    for (uint8_t id = 1; id <= 3; ++id) bank.handle(press(id), changes);
+    CHECK_EQ(bank.byte(0), 0x01);
+    CHECK_EQ(bank.byte(1), 0x20);
+    CHECK_EQ(bank.byte(7), 0x80);
+
+    // Copy out, restore into a fresh bank: same bits, no callbacks
+    Bank restored;
+    for (size_t i = 0; i < Bank::BYTES; ++i) restored.setByte(i, bank.byte(i));
+    for (uint16_t s = 0; s < 64; ++s) CHECK_EQ(restored.get(s), bank.get(s));
+
+    // Each byte lands in its own place without touching its neighbours
+    for (size_t i = 0; i < Bank::BYTES; ++i) restored.setByte(i, static_cast<uint8_t>(0x11 * (i + 1)));
+    restored.setByte(5, 0x00);
+    for (size_t i = 0; i < Bank::BYTES; ++i) CHECK_EQ(restored.byte(i), i == 5 ? 0 : 0x11 * (i + 1));
+    CHECK(restored.get(8 * 7 + 3));  // 0x88: bits 3 and 7 of byte 7
+    CHECK(!restored.get(8 * 7 + 2));
+}
+
+void testFootprint() {
+    // The state: 8 bytes for 64 toggles instead of 64 bools
+    CHECK_EQ(Bank::BYTES, 8u);
+    CHECK_EQ(sizeof(std::array<bool, 64>), 64u);
+    // Without binding tables, the whole bank still fits in less than 64 bools
+    CHECK(sizeof(example::ToggleBank<64, 0, 0>) < sizeof(std::array<bool, 64>));
+    CHECK_EQ(example::ToggleBank<33>::BYTES, 5u);
+    CHECK_EQ(example::ToggleBank<33>::WORDS, 2u);
+}
+
+}  // namespace
+
+int main() {
+    testToggleFlipsOnPressOnly();
+    testRadioGroupClearsAndSetsAcrossWords();
+    testWideBankReportsEveryWord();
+    testBytesRoundTrip();
+    testFootprint();
+    return check::result("ToggleBank");
+}
@@ -0,0 +1,111 @@
+/**
+ * @file test_touch_detector.cpp
+ * @brief TouchDetector: drift tracking, hysteresis, adaptive threshold, stuck touches
+ */
+
+#include <cstdint>
+
+#include "TouchDetector.hpp"
+#include "check.hpp"
+#include "sim.hpp"
+
+namespace {
+
+using example::TouchDetector;
+
+using sim::TICK_US;
+using Feeder = sim::Feeder<TouchDetector>;  // feed() returns the touch state
+
+void testFirstReadingPrimesTheBaseline() {
+    TouchDetector detector;
+    Feeder pad{detector};
+    CHECK(!pad.feed(1000));
+    CHECK_EQ(detector.baseline(), 1000);
+    CHECK_EQ(detector.threshold(), 300);
+}
+
+void testTouchAndReleaseWithHysteresis() {
+    TouchDetector quiet;
+    Feeder atThreshold{quiet};
+    atThreshold.feed(1000, 10);
+    CHECK(!atThreshold.feed(1300));  // At the threshold: not above it
+
+    TouchDetector detector;
+    Feeder pad{detector};
+    pad.feed(1000, 10);
+    CHECK(pad.feed(1301));
+    CHECK(pad.feed(1151));   // Above half the delta: still touched
+    CHECK(!pad.feed(1149));
+    CHECK(!pad.feed(1200));  // Between release and touch: stays released
+}
+
+void testBaselineFollowsDriftWhileUntouched() {
+    TouchDetector detector;
+    Feeder pad{detector};
+    pad.feed(1000, 10);
+
+    // A slow rise (temperature) never reads as a touch
+    for (uint16_t reading = 1000; reading < 1600; reading += 2) {
+        CHECK(!pad.feed(reading, 10));
+    }
+    CHECK(detector.baseline() > 1500);
+    CHECK(pad.feed(detector.baseline() + 400));
+}
+
+void testLongTouchIsNotAbsorbed() {
+    TouchDetector detector;
+    Feeder pad{detector};
+    pad.feed(1000, 10);
+
+    CHECK(pad.feed(1500));
+    CHECK(pad.feed(1500, 10000));  // 10 s held
+    CHECK_EQ(detector.baseline(), 1000);
+    CHECK(!pad.feed(1000));
+}
+
+void testStuckTouchRecalibrates() {
+    TouchDetector::Tuning tuning;
+    tuning.maxTouchUs = 100 * TICK_US;
+    TouchDetector detector{tuning};
+    Feeder pad{detector};
+    pad.feed(1000, 10);
+
+    // The untouched level steps up (water on the pad): reads as a touch...
+    CHECK(pad.feed(1500, 101));
+    // ...until maxTouchUs, where that level becomes the baseline
+    CHECK(!pad.feed(1500));
+    CHECK_EQ(detector.baseline(), 1500);
+    CHECK(!pad.feed(1500, 100));
+
+    // A real touch on top of the new level is seen again
+    CHECK(pad.feed(1900));
+    CHECK(!pad.feed(1500));
+}
+
+void testThresholdAdaptsToNoise() {
+    TouchDetector detector;
+    Feeder pad{detector};
+    pad.feed(1000);
+
+    // +-120 counts of noise: 4 x noise exceeds minDelta
+    for (int i = 0; i < 400; ++i) {
+        CHECK(!pad.feed(i & 1 ? 1120 : 880));
+    }
+    const int32_t threshold = detector.threshold();
+    CHECK(threshold > 300);
+    CHECK(threshold <= 4 * 120);
+    CHECK(!pad.feed(static_cast<uint16_t>(detector.baseline() + 300)));
+    CHECK(pad.feed(static_cast<uint16_t>(detector.baseline() + detector.threshold() + 20)));
+}
+
+}  // namespace
+
+int main() {
+    testFirstReadingPrimesTheBaseline();
+    testTouchAndReleaseWithHysteresis();
+    testBaselineFollowsDriftWhileUntouched();
+    testLongTouchIsNotAbsorbed();
+    testStuckTouchRecalibrates();
+    testThresholdAdaptsToNoise();
+    return check::result("TouchDetector");
+}
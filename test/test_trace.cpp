@@ -0,0 +1,151 @@
+/**
+ * @file test_trace.cpp
+ * @brief TraceBuffer: Chrome JSON export, ordering across ring overflow and cycle wrap
+ *
+ * On the host the trace clock counts nanoseconds: 1000 ticks per us, so a
+ * tick delta of 1500 is printed as 1.500 us.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Trace.hpp"
+#include "check.hpp"
+
+namespace {
+
+using Buffer = example::TraceBuffer<8>;
+
+struct StringOut {
+    std::string text;
+    void write(const char* data, size_t size) { text.append(data, size); }
+};
+
+struct Parsed {
+    std::string name;
+    char phase;
+    double ts;
+    unsigned a, b;
+    bool threadScope;  ///< Carries "s":"t"
+};
+
+/// One event per line between the header and the footer
+std::vector<Parsed> parse(const std::string& json, bool& ok) {
+    std::vector<Parsed> events;
+    ok = json.rfind("{\"traceEvents\":[\n", 0) == 0 && json.size() >= 4 &&
+         json.compare(json.size() - 4, 4, "\n]}\n") == 0;
+    size_t at = json.find('\n') + 1;
+    for (size_t end; (end = json.find('\n', at)) != std::string::npos; at = end + 1) {
+        std::string line = json.substr(at, end - at);
+        if (line == "]}") break;
+        if (!events.empty()) {
+            ok = ok && line[0] == ',';
+            line.erase(0, 1);
+        }
+        char name[32] = {};
+        Parsed p{};
+        if (std::sscanf(line.c_str(), "{\"name\":\"%31[^\"]\",\"ph\":\"%c\",\"ts\":%lf", name, &p.phase, &p.ts) != 3) {
+            ok = false;
+            continue;
+        }
+        const size_t args = line.find("\"args\":{");
+        ok = ok && args != std::string::npos &&
+             std::sscanf(line.c_str() + args, "\"args\":{\"a\":%u,\"b\":%u}}", &p.a, &p.b) == 2;
+        p.name = name;
+        p.threadScope = line.find(",\"s\":\"t\"") != std::string::npos;
+        events.push_back(p);
+    }
+    return events;
+}
+
+std::vector<Parsed> exportEvents(const Buffer& buffer, bool& ok) {
+    StringOut out;
+    buffer.writeChromeJson(out);
+    return parse(out.text, ok);
+}
+
+void testEmptyBufferIsValidJson() {
+    Buffer buffer;
+    StringOut out;
+    buffer.writeChromeJson(out);
+    CHECK(out.text == "{\"traceEvents\":[\n]}\n");
+}
+
+void testPhasesAndArgs() {
+    Buffer buffer;
+    buffer.recordAt(1000, "dispatch", 'B');
+    buffer.recordAt(1500, "sendCC", 'i', 20, 127);
+    buffer.recordAt(4000, "dispatch", 'E');
+
+    bool ok = false;
+    const std::vector<Parsed> events = exportEvents(buffer, ok);
+    CHECK(ok);
+    CHECK_EQ(events.size(), 3u);
+    CHECK(events[0].name == "dispatch" && events[0].phase == 'B' && !events[0].threadScope);
+    CHECK(events[1].name == "sendCC" && events[1].phase == 'i' && events[1].threadScope);
+    CHECK(events[1].a == 20 && events[1].b == 127);
+    CHECK(events[2].phase == 'E' && !events[2].threadScope);
+    // Relative to the first event, in us
+    CHECK_EQ(events[0].ts, 0.0);
+    CHECK_EQ(events[1].ts, 0.5);
+    CHECK_EQ(events[2].ts, 3.0);
+}
+
+void testTimestampsUnwrapAcrossTheCycleCounter() {
+    Buffer buffer;
+    const uint32_t start = 0xFFFFF000u;  // 4096 ticks before the wrap
+    buffer.recordAt(start, "tick", 'B');
+    buffer.recordAt(start + 3000, "tick", 'E');
+    buffer.recordAt(start + 5000, "tick", 'B');  // Past the wrap
+    buffer.recordAt(start + 10000, "tick", 'E');
+
+    bool ok = false;
+    const std::vector<Parsed> events = exportEvents(buffer, ok);
+    CHECK(ok);
+    CHECK_EQ(events.size(), 4u);
+    CHECK_EQ(events[1].ts, 3.0);
+    CHECK_EQ(events[2].ts, 5.0);
+    CHECK_EQ(events[3].ts, 10.0);
+}
+
+void testOverflowKeepsTheNewestOldestFirst() {
+    static const char* const NAMES[] = {"e0", "e1", "e2", "e3", "e4", "e5", "e6",
+                                        "e7", "e8", "e9", "e10", "e11", "e12"};
+    Buffer buffer;
+    // 13 events into 8 slots, 1 us apart, wrapping the counter on the way
+    uint32_t cycles = 0xFFFFE000u;
+    for (uint8_t i = 0; i < 13; ++i, cycles += 1000) buffer.recordAt(cycles, NAMES[i], 'i', i);
+    CHECK_EQ(buffer.size(), 8u);
+
+    bool ok = false;
+    const std::vector<Parsed> events = exportEvents(buffer, ok);
+    CHECK(ok);
+    CHECK_EQ(events.size(), 8u);
+    for (size_t n = 0; n < events.size(); ++n) {
+        CHECK(events[n].name == NAMES[n + 5]);
+        CHECK_EQ(events[n].a, n + 5);
+        CHECK_EQ(events[n].ts, static_cast<double>(n));
+    }
+}
+
+void testCalibrateClearsAndReports() {
+    Buffer buffer;
+    buffer.record("before", 'i');
+    const uint32_t ticks = buffer.calibrate();
+    CHECK_EQ(buffer.size(), 0u);
+    CHECK_EQ(buffer.overheadTicks(), ticks);
+    std::printf("record() overhead on this host: %u ns\n", ticks);
+}
+
+}  // namespace
+
+int main() {
+    testEmptyBufferIsValidJson();
+    testPhasesAndArgs();
+    testTimestampsUnwrapAcrossTheCycleCounter();
+    testOverflowKeepsTheNewestOldestFirst();
+    testCalibrateClearsAndReports();
+    return check::result("Trace");
+}
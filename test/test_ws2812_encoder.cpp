@@ -0,0 +1,126 @@
+/**
+ * @file test_ws2812_encoder.cpp
+ * @brief Ws2812Encoder: the UART stream decodes back to the colors, partial frames
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Ws2812Encoder.hpp"
+#include "check.hpp"
+
+namespace {
+
+constexpr size_t N = 4;
+using Encoder = example::Ws2812Encoder<N>;
+
+/**
+ * Replays the stream as the inverted 7N1 TX line and decodes it the way a
+ * WS2812 does: each group of 3 slots must be [high, bit, low].
+ * Returns the colors as 0xRRGGBB; sets ok = false on a malformed group.
+ */
+std::vector<uint32_t> decode(const uint8_t* stream, size_t bytes, bool& ok) {
+    std::vector<bool> line;
+    for (size_t i = 0; i < bytes; ++i) {
+        line.push_back(true);  // Start bit (low), inverted
+        for (int b = 0; b < 7; ++b) line.push_back(!((stream[i] >> b) & 1u));
+        line.push_back(false);  // Stop bit (high), inverted
+    }
+
+    ok = line.size() % 72 == 0;
+    std::vector<uint32_t> colors;
+    for (size_t p = 0; p + 72 <= line.size(); p += 72) {
+        uint32_t grb = 0;
+        for (size_t bit = 0; bit < 24; ++bit) {
+            const size_t slot = p + bit * 3;
+            if (!line[slot] || line[slot + 2]) ok = false;
+            grb = (grb << 1) | (line[slot + 1] ? 1u : 0u);
+        }
+        colors.push_back(((grb & 0x00FF00) << 8) | ((grb & 0xFF0000) >> 8) | (grb & 0x0000FF));
+    }
+    return colors;
+}
+
+void testEncodeBits() {
+    // Data bits are the inverted line: a 0 sets its bit, 0x12 is the fixed high/low slots
+    CHECK_EQ(Encoder::encodeBits(false, false, false), 0x5B);
+    CHECK_EQ(Encoder::encodeBits(true, true, true), 0x12);
+    CHECK_EQ(Encoder::encodeBits(true, false, false), 0x5A);
+}
+
+void testFirstEncodeSendsEveryPixel() {
+    uint8_t stream[Encoder::BYTES];
+    Encoder encoder{stream};
+    CHECK(encoder.dirty());
+    CHECK_EQ(encoder.encode(), Encoder::BYTES);
+    CHECK(!encoder.dirty());
+    CHECK_EQ(encoder.encode(), 0u);
+
+    bool ok = false;
+    const auto colors = decode(stream, Encoder::BYTES, ok);
+    CHECK(ok);
+    CHECK_EQ(colors.size(), N);
+    for (uint32_t c : colors) CHECK_EQ(c, 0u);
+}
+
+void testStreamDecodesToTheColors() {
+    uint8_t stream[Encoder::BYTES];
+    Encoder encoder{stream};
+    const std::array<uint32_t, N> rgb = {0xFF0000, 0x00FF00, 0x0000FF, 0x5A3C81};
+    for (size_t i = 0; i < N; ++i) encoder.set(i, rgb[i]);
+    const size_t bytes = encoder.encode();
+    CHECK_EQ(bytes, Encoder::BYTES);
+
+    bool ok = false;
+    const auto colors = decode(stream, bytes, ok);
+    CHECK(ok);
+    CHECK_EQ(colors.size(), N);
+    for (size_t i = 0; i < N && i < colors.size(); ++i) CHECK_EQ(colors[i], rgb[i]);
+
+    // GRB on the wire: a pure red pixel starts with 8 zero bits (green)
+    CHECK_EQ(stream[0], Encoder::encodeBits(false, false, false));
+}
+
+void testStreamStopsAfterTheLastChange() {
+    uint8_t stream[Encoder::BYTES];
+    Encoder encoder{stream};
+    encoder.encode();
+
+    encoder.set(1, 0x123456);
+    CHECK_EQ(encoder.encode(), 2 * Encoder::BYTES_PER_PIXEL);
+
+    bool ok = false;
+    auto colors = decode(stream, 2 * Encoder::BYTES_PER_PIXEL, ok);
+    CHECK(ok);
+    CHECK_EQ(colors[1], 0x123456u);
+
+    // Unchanged colors and out-of-range pixels cost nothing
+    encoder.set(1, 0x123456);
+    encoder.set(N, 0xFFFFFF);
+    CHECK(!encoder.dirty());
+
+    // Only the changed span is re-encoded: a stale byte before it survives
+    stream[0] = 0;
+    encoder.set(3, 0x000001);
+    CHECK_EQ(encoder.encode(), Encoder::BYTES);
+    CHECK_EQ(stream[0], 0);
+    colors = decode(stream + 3 * Encoder::BYTES_PER_PIXEL, Encoder::BYTES_PER_PIXEL, ok);
+    CHECK(ok);
+    CHECK_EQ(colors[0], 0x000001u);
+
+    encoder.invalidate();
+    CHECK_EQ(encoder.encode(), Encoder::BYTES);
+    CHECK(stream[0] != 0);
+}
+
+}  // namespace
+
+int main() {
+    testEncodeBits();
+    testFirstEncodeSendsEveryPixel();
+    testStreamDecodesToTheColors();
+    testStreamStopsAfterTheLastChange();
+    return check::result("Ws2812Encoder");
+}
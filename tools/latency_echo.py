@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+"""Echo the device's latency probes back and print its report.
+
+Usage: latency_echo.py [port-substring] [probe-count]
+
+Needs mido with a backend (pip install mido python-rtmidi). The device
+measures round trips on its own clock (see include/LatencyProbe.hpp);
+this tool only sends the start request, echoes probes unchanged and
+decodes the final report.
+"""
+
+import struct
+import sys
+
+import mido
+
+HEADER = [0x7D, 0x03]
+PROBE, REPORT, START = 0x10, 0x11, 0x12
+FIELDS = ("version size sent received lost min_us p50_us p90_us p99_us "
+          "max_us mean_us one_way_p50_us").split()
+
+
+def unpack7(data):
+    raw = bytearray()
+    for i in range(0, len(data), 8):
+        msbs, chunk = data[i], data[i + 1:i + 8]
+        raw.extend(b | (((msbs >> j) & 1) << 7) for j, b in enumerate(chunk))
+    return bytes(raw)
+
+
+def main():
+    match = sys.argv[1] if len(sys.argv) > 1 else ""
+    count = int(sys.argv[2]) if len(sys.argv) > 2 else 100
+    name = next(n for n in mido.get_input_names() if match in n)
+    with mido.open_input(name) as inp, mido.open_output(name) as out:
+        out.send(mido.Message("sysex", data=HEADER + [START, min(count, 127)]))
+        for msg in inp:
+            if msg.type != "sysex" or list(msg.data[:2]) != HEADER:
+                continue
+            if msg.data[2] == PROBE:
+                out.send(msg)
+            elif msg.data[2] == REPORT:
+                raw = unpack7(list(msg.data[3:]))
+                values = struct.unpack("<HH10I", raw[:struct.calcsize("<HH10I")])
+                for field, value in zip(FIELDS, values):
+                    print(f"{field:>16}: {value}")
+                return
+
+
+if __name__ == "__main__":
+    main()
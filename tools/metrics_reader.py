@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Query the device's runtime metrics over SysEx and print them.
+
+Usage: metrics_reader.py [port-substring] [interval-seconds]
+
+Needs mido with a backend (pip install mido python-rtmidi). Sends the
+metrics query (see include/Metrics.hpp) and decodes the response; with an
+interval, queries again until interrupted.
+"""
+
+import struct
+import sys
+import time
+
+import mido
+
+HEADER = [0x7D, 0x03]
+QUERY, RESPONSE = 0x01, 0x02
+# MetricsBlock, in wire order: fields a version does not send are skipped
+FIELDS = ("uptime_ms events_total events_per_second dropped_events "
+          "queue_high_water max_loop_us midi_bytes_sent midi_queue_max_us "
+          "midi_queue_mean_us").split()
+
+
+def unpack7(data):
+    raw = bytearray()
+    for i in range(0, len(data), 8):
+        msbs, chunk = data[i], data[i + 1:i + 8]
+        raw.extend(b | (((msbs >> j) & 1) << 7) for j, b in enumerate(chunk))
+    return bytes(raw)
+
+
+def decode(raw):
+    version, size = struct.unpack_from("<HH", raw)
+    count = min((min(size, len(raw)) - 4) // 4, len(FIELDS))
+    values = struct.unpack_from(f"<{count}I", raw, 4)
+    return version, dict(zip(FIELDS, values))
+
+
+def query(inp, out):
+    out.send(mido.Message("sysex", data=HEADER + [QUERY]))
+    for msg in inp:
+        if msg.type == "sysex" and list(msg.data[:3]) == HEADER + [RESPONSE]:
+            return decode(unpack7(list(msg.data[3:])))
+
+
+def main():
+    match = sys.argv[1] if len(sys.argv) > 1 else ""
+    interval = float(sys.argv[2]) if len(sys.argv) > 2 else 0
+    name = next(n for n in mido.get_input_names() if match in n)
+    with mido.open_input(name) as inp, mido.open_output(name) as out:
+        while True:
+            version, values = query(inp, out)
+            print(f"{'version':>20}: {version}")
+            for field, value in values.items():
+                print(f"{field:>20}: {value}")
+            if not interval:
+                return
+            print()
+            time.sleep(interval)
+
+
+if __name__ == "__main__":
+    main()